@@ -0,0 +1,137 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Monotonic memory for values with common lifetime (for example, values
+   decoded from one batch of records).
+
+   Allocation only moves pointer inside current chunk, deallocation does
+   nothing, all memory is freed at once by 'reset()'. Chunks are kept after
+   'reset()', so repeated use (batch by batch) doesn't call heap at all.
+   Not thread-safe.
+
+   Usage:
+   Pass 'resource' to 'std::pmr' containers or allocate directly, call
+   'reset()' when values are not needed anymore.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <algorithm>
+
+
+namespace arena
+{
+
+    class resource : public std::pmr::memory_resource
+    {
+    private:
+        struct chunk
+        {
+            std::unique_ptr<unsigned char[]> data;
+            std::size_t size = 0;
+        };
+
+        static constexpr std::size_t max_chunk_size = 1024 * 1024;
+
+        std::vector<chunk> chunks;                          // Allocated memory.
+        std::size_t current = 0;                            // Chunk used for allocations.
+        std::size_t offset = 0;                             // Used bytes of the current chunk.
+        std::size_t next_size;                              // Size of the next new chunk.
+        std::size_t used = 0;                               // Allocated bytes after 'reset()'.
+
+        void* do_allocate(std::size_t bytes_, std::size_t align_) override
+        {
+            for (; current < chunks.size(); ++current, offset = 0)
+            {
+                chunk& item = chunks[current];
+                const auto base = reinterpret_cast<std::uintptr_t>(item.data.get());
+                const std::size_t pos = (base + offset + align_ - 1) / align_ * align_ - base;
+
+                if (pos <= item.size && bytes_ <= item.size - pos)
+                {
+                    offset = pos + bytes_;
+                    used += bytes_;
+                    return item.data.get() + pos;
+                }
+            }
+
+            const std::size_t size = std::max(next_size, bytes_ + align_);
+            chunks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[size]), size });
+            next_size = std::min(next_size * 2, std::max(max_chunk_size, next_size));
+
+            return do_allocate(bytes_, align_);
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) noexcept override
+        {
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other_) const noexcept override
+        {
+            return this == &other_;
+        }
+
+    public:
+        // Bytes allocated after 'reset()'.
+        std::size_t size() const noexcept
+        {
+            return used;
+        }
+
+        // Bytes of all chunks.
+        std::size_t capacity() const noexcept
+        {
+            std::size_t total = 0;
+
+            for (const auto& item : chunks)
+                total += item.size;
+
+            return total;
+        }
+
+        // Frees all allocated values, memory is kept for next allocations.
+        void reset() noexcept
+        {
+            current = 0;
+            offset = 0;
+            used = 0;
+        }
+
+        // Same, memory is returned to heap.
+        void release() noexcept
+        {
+            chunks.clear();
+            reset();
+        }
+
+        explicit resource(std::size_t chunk_size_ = 64 * 1024) :
+            next_size(std::max(chunk_size_, std::size_t(64)))
+        {
+        }
+
+        resource(const resource&) = delete;
+        resource(resource&&) = default;
+        resource& operator=(const resource&) = delete;
+        resource& operator=(resource&&) = default;
+    };
+
+}
@@ -0,0 +1,217 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <cassert>
+#include <cstring>
+
+#include "bcd.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define BCD_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace bcd
+{
+
+    namespace
+    {
+
+        constexpr std::uint8_t positive = 1;                // Value of sign half-byte.
+        constexpr std::uint64_t pow10_8 = 100000000;
+        constexpr std::uint64_t pow10_19 = 10000000000000000000u;
+
+
+        // Digit 'i_' (0 - sign half-byte).
+        inline unsigned nibble(const std::uint8_t* src_, std::size_t i_) noexcept
+        {
+            return i_ % 2 == 0 ? src_[i_ / 2] >> 4 : src_[i_ / 2] & 0x0F;
+        }
+
+
+        // Digits [first_, last_) as integer, up to 19 digits.
+        inline std::uint64_t digits(const std::uint8_t* src_, std::size_t first_, std::size_t last_) noexcept
+        {
+            std::uint64_t result = 0;
+
+            for (std::size_t i = first_; i < last_; ++i)
+                result = result * 10 + nibble(src_, i);
+
+            return result;
+        }
+
+
+        // 'a_' * 'b_' + 'c_' for 64-bit values into 128-bit.
+        inline int128 mul_add(std::uint64_t a_, std::uint64_t b_, std::uint64_t c_) noexcept
+        {
+            const std::uint64_t a_lo = a_ & 0xFFFFFFFF, a_hi = a_ >> 32;
+            const std::uint64_t b_lo = b_ & 0xFFFFFFFF, b_hi = b_ >> 32;
+
+            const std::uint64_t lo_lo = a_lo * b_lo;
+            const std::uint64_t hi_lo = a_hi * b_lo;
+            const std::uint64_t lo_hi = a_lo * b_hi;
+            const std::uint64_t hi_hi = a_hi * b_hi;
+
+            const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+
+            std::uint64_t low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+            std::uint64_t high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+
+            low += c_;
+            high += low < c_ ? 1 : 0;
+
+            int128 result;
+            result.low = low;
+            result.high = static_cast<std::int64_t>(high);
+            return result;
+        }
+
+
+#ifdef BCD_SSE2
+
+        // Value of 'length_' digits: half-bytes are unpacked to bytes, aligned
+        // so that the last digit is the last byte of 32, then pairs of digits,
+        // pairs of pairs and so on are summed by 'pmaddwd'.
+        inline std::uint64_t digits_sse2(const std::uint8_t* src_, std::size_t length_) noexcept
+        {
+            alignas(16) std::uint8_t unpacked[64] = {};
+
+            const __m128i low_mask = _mm_set1_epi8(0x0F);
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_));
+            const __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), low_mask);
+            const __m128i low = _mm_and_si128(v, low_mask);
+
+            // Half-byte 'i' to byte 'i': high half-byte goes first.
+            _mm_store_si128(reinterpret_cast<__m128i*>(unpacked + 32), _mm_unpacklo_epi8(high, low));
+            _mm_store_si128(reinterpret_cast<__m128i*>(unpacked + 48), _mm_unpackhi_epi8(high, low));
+            unpacked[32] = 0;                               // Sign.
+
+            // Bytes 0..31: digits with the last at byte 31, zeros before.
+            const std::uint8_t* aligned = unpacked + 32 + length_ - 31;
+            const __m128i d0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aligned));
+            const __m128i d1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aligned + 16));
+
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i mul_10 = _mm_set1_epi32(0x0001000A);        // Pairs (10, 1).
+            const __m128i mul_100 = _mm_set1_epi32(0x00010064);       // Pairs (100, 1).
+            const __m128i mul_10000 = _mm_set1_epi32(0x00012710);     // Pairs (10000, 1).
+
+            // Two digits: 0..99 in 32-bit lanes.
+            const __m128i p0 = _mm_madd_epi16(_mm_unpacklo_epi8(d0, zero), mul_10);
+            const __m128i p1 = _mm_madd_epi16(_mm_unpackhi_epi8(d0, zero), mul_10);
+            const __m128i p2 = _mm_madd_epi16(_mm_unpacklo_epi8(d1, zero), mul_10);
+            const __m128i p3 = _mm_madd_epi16(_mm_unpackhi_epi8(d1, zero), mul_10);
+
+            // Four digits: 0..9999 in 32-bit lanes.
+            const __m128i q0 = _mm_madd_epi16(_mm_packs_epi32(p0, p1), mul_100);
+            const __m128i q1 = _mm_madd_epi16(_mm_packs_epi32(p2, p3), mul_100);
+
+            // Eight digits in 32-bit lanes: digits 0..7, 8..15, 16..23, 24..31.
+            alignas(16) std::uint32_t parts[4];
+            _mm_store_si128(
+                reinterpret_cast<__m128i*>(parts),
+                _mm_madd_epi16(_mm_packs_epi32(q0, q1), mul_10000));
+
+            return (static_cast<std::uint64_t>(parts[1]) * pow10_8 + parts[2]) * pow10_8 + parts[3];
+        }
+
+#endif
+
+    }
+
+
+    std::int64_t to_int64(const void* src_, std::size_t length_) noexcept
+    {
+        assert(length_ <= max_int64_digits);
+
+        const auto* src = static_cast<const std::uint8_t*>(src_);
+        const auto value = static_cast<std::int64_t>(digits(src, 1, length_ + 1));
+
+        return nibble(src, 0) == positive ? value : -value;
+    }
+
+
+    int128 to_int128(const void* src_, std::size_t length_) noexcept
+    {
+        assert(length_ <= max_int128_digits);
+
+        const auto* src = static_cast<const std::uint8_t*>(src_);
+
+        // Low 19 digits and the rest.
+        const std::size_t split = length_ > 19 ? length_ - 19 + 1 : 1;
+        int128 result = mul_add(digits(src, 1, split), pow10_19, digits(src, split, length_ + 1));
+
+        if (nibble(src, 0) != positive)
+        {
+            result.low = ~result.low + 1;
+            result.high = static_cast<std::int64_t>(
+                ~static_cast<std::uint64_t>(result.high) + (result.low == 0 ? 1 : 0));
+        }
+
+        return result;
+    }
+
+
+    double to_double(const void* src_, std::size_t length_, std::size_t precision_) noexcept
+    {
+        const auto* src = static_cast<const std::uint8_t*>(src_);
+
+        const std::size_t split = length_ > 19 ? length_ - 19 + 1 : 1;
+        double value =
+            static_cast<double>(digits(src, 1, split)) * 1e19 +
+            static_cast<double>(digits(src, split, length_ + 1));
+
+        double scale = 1;
+
+        for (std::size_t i = 0; i < precision_; ++i)
+            scale *= 10;
+
+        value /= scale;
+
+        return nibble(src, 0) == positive ? value : -value;
+    }
+
+
+    void to_int64(
+        const void* src_, std::size_t stride_, std::size_t count_,
+        std::size_t length_,
+        std::int64_t* dst_) noexcept
+    {
+        assert(length_ <= max_int64_digits);
+
+        const auto* src = static_cast<const std::uint8_t*>(src_);
+        std::size_t i = 0;
+
+#ifdef BCD_SSE2
+        // Vector load takes 16 bytes: values near end of the buffer are scalar.
+        const std::size_t total = stride_ * count_;
+
+        for (; i < count_ && total - stride_ * i >= 16; ++i)
+        {
+            const std::uint8_t* value = src + stride_ * i;
+            const auto result = static_cast<std::int64_t>(digits_sse2(value, length_));
+
+            dst_[i] = (value[0] >> 4) == positive ? result : -result;
+        }
+#endif
+
+        for (; i < count_; ++i)
+            dst_[i] = to_int64(src + stride_ * i, length_);
+    }
+
+}
@@ -0,0 +1,74 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Decoding of packed decimal numbers ('digit' fields of the tables).
+
+   Value takes '(length + 2) / 2' bytes. First half-byte is sign (1 - positive,
+   0 - negative), then 'length' decimal digits from high to low, one digit in
+   half-byte. Last 'precision' digits are fraction. Results are integers
+   without decimal point ('unscaled'): value is 'result / 10^precision'.
+
+   Values up to 18 digits are decoded to 'std::int64_t', up to 38 digits - to
+   128-bit integer. Batch decoding of column values to 'std::int64_t' unpacks
+   half-bytes and sums digits by SSE2.
+
+   Usage:
+   Call 'to_int64()', 'to_int128()' or 'to_double()' for one value with
+   'length' and 'precision' of the field. For columns of values use batch
+   'to_int64()' with stride between values.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace bcd
+{
+
+    constexpr std::size_t max_int64_digits = 18;            // Any 18 digits fit to 'std::int64_t'.
+    constexpr std::size_t max_int128_digits = 38;           // Same for 128-bit integer.
+
+    // Two's complement 128-bit integer.
+    struct int128
+    {
+        std::uint64_t low = 0;
+        std::int64_t high = 0;
+
+        bool operator==(const int128& other_) const noexcept
+        {
+            return low == other_.low && high == other_.high;
+        }
+    };
+
+    // 'length_' - up to 'max_int64_digits'.
+    std::int64_t to_int64(const void* src_, std::size_t length_) noexcept;
+
+    // 'length_' - up to 'max_int128_digits'.
+    int128 to_int128(const void* src_, std::size_t length_) noexcept;
+
+    // Value with decimal point (nearest double).
+    double to_double(const void* src_, std::size_t length_, std::size_t precision_) noexcept;
+
+    // 'count_' values placed by 'stride_' bytes, 'length_' - up to 'max_int64_digits'.
+    void to_int64(
+        const void* src_, std::size_t stride_, std::size_t count_,
+        std::size_t length_,
+        std::int64_t* dst_) noexcept;
+
+}
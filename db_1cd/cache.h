@@ -16,7 +16,8 @@
 */
 /*
    Class templates implemented simple cache algorithms:
-   FIFO, LRU, 2Q (http://www.vldb.org/conf/1994/P439.PDF).
+   FIFO, LRU, 2Q (http://www.vldb.org/conf/1994/P439.PDF) and LRU with limit
+   of the items total weight (size of values in bytes).
 
    To reduce CPU overhead used 'std::vector' internally. Nothing lists or
    associative containers: https://dzone.com/articles/c-benchmark--stdvector-vs
@@ -31,11 +32,16 @@
    with associated value.
 3. Call 'push()' to put new element in queue. If no free space, returned 
    'std::optional' contains oldest element of queue.
+   'weighted_lru::push()' takes weight of the element and returns all evicted
+   elements (or the element itself if it heavier than limit). Element with
+   the same key is replaced (and returned as evicted).
 */
 
 #pragma once
 
 #include <vector>
+#include <list>
+#include <unordered_map>
 #include <optional>
 #include <utility>
 #include <cassert>
@@ -333,4 +339,106 @@ namespace cache
         twoq& operator=(twoq&&) = default;
     };
 
+
+    // Items count depends from their weight and can be large, so list and hash
+    // table used instead of 'std::vector'.
+    template <typename Tindex, typename Tvalue>
+    class weighted_lru
+    {
+    public:
+        using item_type = std::pair<Tindex, Tvalue>;
+        using size_type = std::size_t;
+
+    private:
+        struct node
+        {
+            item_type item;                                 // Pair 'key/value'.
+            size_type weight;                               // Weight of the value.
+        };
+
+        using cont_type = std::list<node>;
+        using iterator = typename cont_type::iterator;
+
+        const size_type max_weight;                         // Maximum total weight of the 'items'.
+        size_type weight = 0;                               // Current total weight.
+        cont_type items;                                    // Items, first - most recently used.
+        std::unordered_map<Tindex, iterator> indexes;       // Items by keys.
+
+    public:
+        size_type total_weight() const noexcept
+        {
+            return weight;
+        }
+
+        std::optional<Tvalue> find(Tindex index_)
+        {
+            std::optional<Tvalue> result;
+
+            auto i_res = indexes.find(index_);
+
+            if (i_res != indexes.end())
+            {
+                items.splice(items.begin(), items, i_res->second);
+                result = i_res->second->item.second;
+            }
+
+            return result;
+        }
+
+        std::vector<item_type> push(item_type value_, size_type weight_)
+        {
+            std::vector<item_type> result;
+
+            auto i_old = indexes.find(value_.first);
+
+            if (i_old != indexes.end())                     // Replaced value is evicted too.
+            {
+                weight -= i_old->second->weight;
+                result.emplace_back(std::move(i_old->second->item));
+                items.erase(i_old->second);
+                indexes.erase(i_old);
+            }
+
+            if (weight_ > max_weight)
+            {
+                result.emplace_back(std::move(value_));
+                return result;
+            }
+
+            while (max_weight - weight < weight_)
+            {
+                node& last = items.back();
+
+                weight -= last.weight;
+                indexes.erase(last.item.first);
+                result.emplace_back(std::move(last.item));
+                items.pop_back();
+            }
+
+            items.push_front(node{ std::move(value_), weight_ });
+            indexes.emplace(items.front().item.first, items.begin());
+            weight += weight_;
+
+            return result;
+        }
+
+        void clear() noexcept
+        {
+            items.clear();
+            indexes.clear();
+            weight = 0;
+        }
+
+        weighted_lru(size_type max_weight_) :
+            max_weight(max_weight_)
+        {
+            assert(max_weight_ >= 1);                       // Needed at least one unit of weight.
+        }
+
+        weighted_lru(const weighted_lru&) = delete;
+        weighted_lru(weighted_lru&&) = default;
+        weighted_lru& operator=(const weighted_lru&) = delete;
+        weighted_lru& operator=(weighted_lru&&) = default;
+    };
+
 }
@@ -0,0 +1,74 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "cpu.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+
+namespace cpu
+{
+
+    namespace
+    {
+
+        bool detect_avx2() noexcept
+        {
+#if !defined(CPU_X86)
+            return false;
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+
+            if (info[0] < 7)
+                return false;
+
+            __cpuid(info, 1);
+
+            constexpr int osxsave = 1 << 27;
+            constexpr int avx = 1 << 28;
+
+            if ((info[2] & (osxsave | avx)) != (osxsave | avx) ||
+                (_xgetbv(0) & 6) != 6)                      // OS saves YMM registers.
+            {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+
+    }
+
+
+    bool avx2_supported() noexcept
+    {
+        static const bool supported = detect_avx2();
+        return supported;
+    }
+
+}
@@ -0,0 +1,35 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Features of the processor for choosing of vectorized code at runtime.
+   Internal module of the library (used by 'utf8.cpp' and 'rows.cpp').
+
+   Usage:
+   Check 'avx2_supported()' once and call code compiled for AVX2 only if it
+   returns 'true'.
+*/
+
+#pragma once
+
+
+namespace cpu
+{
+
+    // Processor has AVX2 and OS saves YMM registers. Checked once.
+    bool avx2_supported() noexcept;
+
+}
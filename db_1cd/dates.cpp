@@ -0,0 +1,367 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <cstring>
+
+#include "dates.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define DATES_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace dates
+{
+
+    namespace
+    {
+
+        constexpr std::int64_t seconds_per_day = 86400;
+
+
+        // Components of date and time as binary numbers.
+        struct civil
+        {
+            int year = 0;
+            int month = 0;
+            int day = 0;
+            int hour = 0;
+            int minute = 0;
+            int second = 0;
+        };
+
+
+        // Days from 1970-01-01 (H. Hinnant, 'chrono-Compatible Low-Level Date Algorithms').
+        inline std::int64_t days_from_civil(int year_, int month_, int day_) noexcept
+        {
+            const int y = year_ - (month_ <= 2 ? 1 : 0);
+            const int era = (y >= 0 ? y : y - 399) / 400;
+            const int yoe = y - era * 400;
+            const int doy = (153 * (month_ + (month_ > 2 ? -3 : 9)) + 2) / 5 + day_ - 1;
+            const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+            return static_cast<std::int64_t>(era) * 146097 + doe - 719468;
+        }
+
+
+        inline civil civil_from_days(std::int64_t days_) noexcept
+        {
+            days_ += 719468;
+
+            const std::int64_t era = (days_ >= 0 ? days_ : days_ - 146096) / 146097;
+            const auto doe = static_cast<int>(days_ - era * 146097);
+            const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const int mp = (5 * doy + 2) / 153;
+
+            civil result;
+            result.day = doy - (153 * mp + 2) / 5 + 1;
+            result.month = mp < 10 ? mp + 3 : mp - 9;
+            result.year = static_cast<int>(yoe + era * 400) + (result.month <= 2 ? 1 : 0);
+            return result;
+        }
+
+
+        inline bool is_valid(const civil& value_) noexcept
+        {
+            constexpr unsigned char month_days[] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+            if (value_.year < 1 || value_.year > 9999 ||
+                value_.month < 1 || value_.month > 12 ||
+                value_.day < 1 || value_.day > month_days[value_.month - 1] ||
+                value_.hour > 23 || value_.minute > 59 || value_.second > 59)
+            {
+                return false;
+            }
+
+            const bool leap =
+                value_.year % 4 == 0 &&
+                (value_.year % 100 != 0 || value_.year % 400 == 0);
+
+            return value_.month != 2 || value_.day <= 28 || leap;
+        }
+
+
+        // Packed decimal: 'false' for half-byte above 9.
+        inline bool from_bcd(const std::uint8_t* src_, civil& value_) noexcept
+        {
+            std::uint8_t pairs[value_size];
+
+            for (std::size_t i = 0; i < value_size; ++i)
+            {
+                const unsigned high = src_[i] >> 4;
+                const unsigned low = src_[i] & 0x0F;
+
+                if (high > 9 || low > 9)
+                    return false;
+
+                pairs[i] = static_cast<std::uint8_t>(high * 10 + low);
+            }
+
+            value_.year = pairs[0] * 100 + pairs[1];
+            value_.month = pairs[2];
+            value_.day = pairs[3];
+            value_.hour = pairs[4];
+            value_.minute = pairs[5];
+            value_.second = pairs[6];
+            return true;
+        }
+
+
+        inline void from_binary(const std::uint8_t* src_, civil& value_) noexcept
+        {
+            value_.year = src_[0] | (src_[1] << 8);
+            value_.month = src_[2];
+            value_.day = src_[3];
+            value_.hour = src_[4];
+            value_.minute = src_[5];
+            value_.second = src_[6];
+        }
+
+
+        inline std::uint8_t to_bcd(int value_) noexcept
+        {
+            return static_cast<std::uint8_t>(((value_ / 10) << 4) | (value_ % 10));
+        }
+
+
+        // Writes components in the form 'format_' (7 bytes).
+        inline void to_format(const civil& value_, format format_, std::uint8_t* dst_) noexcept
+        {
+            if (format_ == format::bcd)
+            {
+                dst_[0] = to_bcd(value_.year / 100);
+                dst_[1] = to_bcd(value_.year % 100);
+                dst_[2] = to_bcd(value_.month);
+                dst_[3] = to_bcd(value_.day);
+                dst_[4] = to_bcd(value_.hour);
+                dst_[5] = to_bcd(value_.minute);
+                dst_[6] = to_bcd(value_.second);
+            }
+            else
+            {
+                dst_[0] = static_cast<std::uint8_t>(value_.year & 0xFF);
+                dst_[1] = static_cast<std::uint8_t>(value_.year >> 8);
+                dst_[2] = static_cast<std::uint8_t>(value_.month);
+                dst_[3] = static_cast<std::uint8_t>(value_.day);
+                dst_[4] = static_cast<std::uint8_t>(value_.hour);
+                dst_[5] = static_cast<std::uint8_t>(value_.minute);
+                dst_[6] = static_cast<std::uint8_t>(value_.second);
+            }
+        }
+
+
+        // Seconds (or days, if 'Tdays') of valid value, 'invalid' for others.
+        template <bool Tdays>
+        inline std::int64_t convert(const civil& value_) noexcept
+        {
+            if (!is_valid(value_))
+                return invalid;
+
+            const std::int64_t days = days_from_civil(value_.year, value_.month, value_.day);
+
+            if constexpr (Tdays)
+                return days;
+            else
+                return days * seconds_per_day + value_.hour * 3600 + value_.minute * 60 + value_.second;
+        }
+
+
+#ifdef DATES_SSE2
+
+        // Unpacks packed decimal values of two records (8 bytes from each, 7
+        // used) to bytes 0..99. Returns mask of the valid values (bit per value).
+        inline unsigned pairs_sse2(
+            const std::uint8_t* first_, const std::uint8_t* second_,
+            std::uint8_t* pairs_) noexcept
+        {
+            std::uint64_t a = 0, b = 0;
+            std::memcpy(&a, first_, sizeof(a));
+            std::memcpy(&b, second_, sizeof(b));
+
+            const __m128i v = _mm_set_epi64x(static_cast<long long>(b), static_cast<long long>(a));
+            const __m128i low_mask = _mm_set1_epi8(0x0F);
+            const __m128i nine = _mm_set1_epi8(9);
+
+            const __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), low_mask);
+            const __m128i low = _mm_and_si128(v, low_mask);
+
+            // 'high * 10 + low': 'high * 8' and 'high * 2' don't overflow bytes.
+            const __m128i pairs = _mm_add_epi8(
+                _mm_add_epi8(_mm_slli_epi16(high, 3), _mm_slli_epi16(high, 1)),
+                low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pairs_), pairs);
+
+            const int bad = _mm_movemask_epi8(_mm_or_si128(
+                _mm_cmpgt_epi8(high, nine),
+                _mm_cmpgt_epi8(low, nine)));
+
+            return ((bad & 0x7F) == 0 ? 1 : 0) | ((bad & 0x7F00) == 0 ? 2 : 0);
+        }
+
+
+        inline civil from_pairs(const std::uint8_t* pairs_) noexcept
+        {
+            civil result;
+            result.year = pairs_[0] * 100 + pairs_[1];
+            result.month = pairs_[2];
+            result.day = pairs_[3];
+            result.hour = pairs_[4];
+            result.minute = pairs_[5];
+            result.second = pairs_[6];
+            return result;
+        }
+
+#endif
+
+
+        template <bool Tdays>
+        std::size_t convert_all(
+            const std::uint8_t* src_, std::size_t stride_, std::size_t count_,
+            format format_,
+            std::int64_t* dst_) noexcept
+        {
+            std::size_t i = 0;
+
+#ifdef DATES_SSE2
+            // Vector path reads 8 bytes of the value: last value is scalar.
+            if (format_ == format::bcd)
+            {
+                alignas(16) std::uint8_t pairs[16];
+
+                for (; i + 2 < count_; i += 2)
+                {
+                    const unsigned valid = pairs_sse2(src_ + stride_ * i, src_ + stride_ * (i + 1), pairs);
+
+                    dst_[i] = valid & 1 ? convert<Tdays>(from_pairs(pairs)) : invalid;
+                    dst_[i + 1] = valid & 2 ? convert<Tdays>(from_pairs(pairs + 8)) : invalid;
+                }
+            }
+#endif
+
+            for (; i < count_; ++i)
+            {
+                civil value;
+
+                if (format_ == format::bcd)
+                {
+                    if (!from_bcd(src_ + stride_ * i, value))
+                    {
+                        dst_[i] = invalid;
+                        continue;
+                    }
+                }
+                else
+                    from_binary(src_ + stride_ * i, value);
+
+                dst_[i] = convert<Tdays>(value);
+            }
+
+            std::size_t errors = 0;
+
+            for (i = 0; i < count_; ++i)
+                errors += dst_[i] == invalid ? 1 : 0;
+
+            return errors;
+        }
+
+    }
+
+
+    std::size_t to_seconds(
+        const void* src_, std::size_t stride_, std::size_t count_,
+        format format_,
+        std::int64_t* dst_) noexcept
+    {
+        return convert_all<false>(static_cast<const std::uint8_t*>(src_), stride_, count_, format_, dst_);
+    }
+
+
+    std::size_t to_days(
+        const void* src_, std::size_t stride_, std::size_t count_,
+        format format_,
+        std::int64_t* dst_) noexcept
+    {
+        return convert_all<true>(static_cast<const std::uint8_t*>(src_), stride_, count_, format_, dst_);
+    }
+
+
+    std::size_t from_seconds(
+        const std::int64_t* src_, std::size_t count_,
+        format format_,
+        void* dst_, std::size_t stride_) noexcept
+    {
+        constexpr std::int64_t min_seconds = -62135596800;  // 0001-01-01 00:00:00.
+        constexpr std::int64_t max_seconds = 253402300799;  // 9999-12-31 23:59:59.
+
+        auto* dst = static_cast<std::uint8_t*>(dst_);
+        std::size_t errors = 0;
+
+        for (std::size_t i = 0; i < count_; ++i, dst += stride_)
+        {
+            const std::int64_t seconds = src_[i];
+
+            if (seconds < min_seconds || seconds > max_seconds)
+            {
+                std::memset(dst, 0, value_size);
+                ++errors;
+                continue;
+            }
+
+            const std::int64_t days = (seconds >= 0 ? seconds : seconds - seconds_per_day + 1) / seconds_per_day;
+            const auto time = static_cast<int>(seconds - days * seconds_per_day);
+
+            civil value = civil_from_days(days);
+            value.hour = time / 3600;
+            value.minute = time / 60 % 60;
+            value.second = time % 60;
+
+            to_format(value, format_, dst);
+        }
+
+        return errors;
+    }
+
+
+    std::size_t from_days(
+        const std::int64_t* src_, std::size_t count_,
+        format format_,
+        void* dst_, std::size_t stride_) noexcept
+    {
+        constexpr std::int64_t min_days = -719162;          // 0001-01-01.
+        constexpr std::int64_t max_days = 2932896;          // 9999-12-31.
+
+        auto* dst = static_cast<std::uint8_t*>(dst_);
+        std::size_t errors = 0;
+
+        for (std::size_t i = 0; i < count_; ++i, dst += stride_)
+        {
+            if (src_[i] < min_days || src_[i] > max_days)
+            {
+                std::memset(dst, 0, value_size);
+                ++errors;
+                continue;
+            }
+
+            to_format(civil_from_days(src_[i]), format_, dst);
+        }
+
+        return errors;
+    }
+
+}
@@ -0,0 +1,80 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Batch conversion of 'datetime' field values to count of seconds (or days)
+   from 1970-01-01 00:00:00 and back.
+
+   Value takes 7 bytes in one of two forms:
+   - packed decimal 'YYYYMMDDhhmmss', two digits in byte (as stored by 1C);
+   - binary: year (2 bytes, little-endian), month, day, hour, minute, second
+     (layout of 'db_1cd_8x::field::datetime::value_type' in memory on x86,
+     for values decoded already; records never store this form).
+   Packed digits of two values are unpacked and checked by one SSE2 operation.
+   Dates are in proleptic Gregorian calendar, years 1..9999. Invalid values
+   (wrong digits, month, day, time) are marked as 'invalid'.
+
+   Usage:
+   Call 'to_seconds()' or 'to_days()' with values placed by 'stride_' bytes
+   (for example, the field in buffer of records). Back conversion - by
+   'from_seconds()' or 'from_days()'.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+
+namespace dates
+{
+
+    enum class format
+    {
+        bcd,                                                // Packed decimal 'YYYYMMDDhhmmss'.
+        binary                                              // Year (2 bytes) and the rest by byte.
+    };
+
+    constexpr std::size_t value_size = 7;                   // Size of the one value (bytes).
+    constexpr std::int64_t invalid = std::numeric_limits<std::int64_t>::min();
+
+    // Returns count of invalid values.
+    std::size_t to_seconds(
+        const void* src_, std::size_t stride_, std::size_t count_,
+        format format_,
+        std::int64_t* dst_) noexcept;
+
+    // Same, time is checked and dropped.
+    std::size_t to_days(
+        const void* src_, std::size_t stride_, std::size_t count_,
+        format format_,
+        std::int64_t* dst_) noexcept;
+
+    // Seconds out of years 1..9999 (and 'invalid') are written as zero bytes.
+    // Returns count of such values.
+    std::size_t from_seconds(
+        const std::int64_t* src_, std::size_t count_,
+        format format_,
+        void* dst_, std::size_t stride_) noexcept;
+
+    // Same for days, time is 00:00:00.
+    std::size_t from_days(
+        const std::int64_t* src_, std::size_t count_,
+        format format_,
+        void* dst_, std::size_t stride_) noexcept;
+
+}
@@ -15,6 +15,8 @@
    limitations under the License.
 */
 
+#include <algorithm>
+
 #include "db_1cd_83.h"
 
 
@@ -104,17 +106,41 @@ db_1cd_83::object::page_num_to_index_lite(pages::index_type page_num_) const
 }
 
 
-void db_1cd_83::object::read(void* dst_buff_, std::size_t count_, object::size_type pos_)
+void db_1cd_83::object::check_interval(std::size_t count_, object::size_type pos_) const
 {
-    auto *hdr = reinterpret_cast<const obj_hdr*>(hdr_page.data());
-
-    if (pos_ >= hdr->length ||
-        (pos_ + count_) > hdr->length ||
+    if (pos_ >= size() ||
+        (pos_ + count_) > size() ||
         (pos_ + count_) < pos_)                             // Overflow checking.
     {
         throw exception(
             "Requested interval to read exceeds object size.");
     }
+}
+
+
+const void* db_1cd_83::object::view(std::size_t count_, object::size_type pos_)
+{
+    check_interval(count_, pos_);
+
+    const std::size_t page_size = pages_iface.page_size();
+    const auto page_num = static_cast<pages::index_type>(pos_ / page_size);
+    const std::size_t pos_in_page = pos_ % page_size;
+
+    if (count_ > page_size - pos_in_page)
+    {
+        throw exception(
+            "Requested interval to view exceeds object page.");
+    }
+
+    return pages_iface.view(
+        page_index(page_num),
+        count_, pos_in_page);
+}
+
+
+void db_1cd_83::object::read(void* dst_buff_, std::size_t count_, object::size_type pos_)
+{
+    check_interval(count_, pos_);
 
     const std::size_t page_size = pages_iface.page_size();
     pages::index_type page_num = static_cast<pages::index_type>(pos_ / page_size);
@@ -128,13 +154,8 @@ void db_1cd_83::object::read(void* dst_buff_, std::size_t count_, object::size_t
         if (count_ < to_read)
             to_read = count_;
 
-        const pages::index_type page_index =
-            hdr->pmt_type == 0x01 ?
-            page_num_to_index(page_num) :
-            page_num_to_index_lite(page_num);
-
         pages_iface.read(
-            dst_buff__, page_index,
+            dst_buff__, page_index(page_num),
             to_read, pos_in_page);
 
         count_ -= to_read;
@@ -145,6 +166,175 @@ void db_1cd_83::object::read(void* dst_buff_, std::size_t count_, object::size_t
 }
 
 
+db_1cd_83::pages::index_type db_1cd_83::object::interval_pages(
+    std::size_t count_, object::size_type pos_,
+    std::vector<pages::index_type>& indexes_)
+{
+    check_interval(count_, pos_);
+
+    const std::size_t page_size = pages_iface.page_size();
+    const auto first_page = static_cast<pages::index_type>(pos_ / page_size);
+
+    indexes_.clear();
+
+    if (count_ == 0)                                        // No pages (and no last page).
+        return first_page;
+
+    const auto last_page = static_cast<pages::index_type>((pos_ + count_ - 1) / page_size);
+
+    indexes_.reserve(static_cast<std::size_t>(last_page - first_page) + 1);
+
+    for (pages::index_type page_num = first_page; page_num <= last_page; ++page_num)
+        indexes_.push_back(page_index(page_num));
+
+    return first_page;
+}
+
+
+void db_1cd_83::object::read_pages(
+    void* dst_buff_,
+    std::size_t count_, object::size_type pos_,
+    pages::index_type first_page_, std::size_t page_size_,
+    const std::vector<pages::index_type>& indexes_,
+    std::size_t i_begin_, std::size_t i_end_) const
+{
+    const std::size_t page_size = page_size_;
+    auto* dst_buff__ = reinterpret_cast<unsigned char*>(dst_buff_);
+    const object::size_type end_pos = pos_ + count_;
+
+    std::size_t i_page = i_begin_;
+
+    while (i_page != i_end_)
+    {
+        // Physically consecutive pages are read by one request.
+        std::size_t i_next = i_page + 1;
+
+        while (i_next != i_end_ &&
+            indexes_[i_next] == indexes_[i_next - 1] + 1)
+        {
+            ++i_next;
+        }
+
+        const object::size_type page_pos =
+            static_cast<object::size_type>(first_page_ + i_page) * page_size;
+        const object::size_type run_begin = std::max(page_pos, pos_);
+        const object::size_type run_end = std::min(
+            static_cast<object::size_type>(first_page_ + i_next) * page_size,
+            end_pos);
+
+        pages_iface.read_direct(
+            dst_buff__ + (run_begin - pos_),
+            indexes_[i_page],
+            static_cast<std::size_t>(run_end - run_begin),
+            static_cast<std::size_t>(run_begin - page_pos));
+
+        i_page = i_next;
+    }
+}
+
+
+void db_1cd_83::object::read(
+    void* dst_buff_,
+    std::size_t count_, object::size_type pos_,
+    workers::pool& workers_)
+{
+    read({ interval{ dst_buff_, count_, pos_ } }, workers_);
+}
+
+
+void db_1cd_83::object::read(
+    const std::vector<interval>& intervals_,
+    workers::pool& workers_)
+{
+    struct chunk
+    {
+        std::size_t i_interval;                             // Interval of the chunk.
+        std::size_t i_begin;                                // Pages of the interval.
+        std::size_t i_end;
+    };
+
+    const std::size_t page_size = pages_iface.page_size();
+
+    constexpr std::size_t chunk_bytes = 1024 * 1024;        // Data size for the one task.
+    const std::size_t chunk_pages = std::max<std::size_t>(chunk_bytes / page_size, 1);
+
+    // Placement tables are read through the pages cache - only by this thread.
+    std::vector<std::vector<pages::index_type>> indexes(intervals_.size());
+    std::vector<pages::index_type> first_pages(intervals_.size());
+    std::vector<chunk> chunks;
+
+    for (std::size_t i = 0; i < intervals_.size(); ++i)
+    {
+        first_pages[i] = interval_pages(intervals_[i].count, intervals_[i].pos, indexes[i]);
+
+        for (std::size_t i_begin = 0; i_begin < indexes[i].size(); i_begin += chunk_pages)
+            chunks.push_back({ i, i_begin, std::min(i_begin + chunk_pages, indexes[i].size()) });
+    }
+
+    workers_.for_each(chunks.size(), [&](std::size_t chunk_)
+    {
+        const chunk& item = chunks[chunk_];
+        const interval& src = intervals_[item.i_interval];
+
+        read_pages(
+            src.dst_buff, src.count, src.pos,
+            first_pages[item.i_interval], page_size, indexes[item.i_interval],
+            item.i_begin, item.i_end);
+    });
+}
+
+
+void db_1cd_83::object::read_parts(
+    void* dst_buff_,
+    std::size_t count_, object::size_type pos_,
+    std::size_t part_size_,
+    workers::pool& workers_,
+    const std::function<void(std::size_t)>& func_)
+{
+    assert(part_size_ > 0);
+
+    // Placement tables are read through the pages cache - only by this thread.
+    std::vector<pages::index_type> indexes;
+    const pages::index_type first_page = interval_pages(count_, pos_, indexes);
+
+    const std::size_t page_size = pages_iface.page_size();
+    const std::size_t parts = (count_ + part_size_ - 1) / part_size_;
+
+    workers_.for_each(parts, [&](std::size_t part_)
+    {
+        const std::size_t offset = part_ * part_size_;
+        const std::size_t count = std::min(part_size_, count_ - offset);
+        const object::size_type pos = pos_ + offset;
+
+        const std::size_t i_begin = static_cast<std::size_t>(pos / page_size - first_page);
+        const std::size_t i_end = static_cast<std::size_t>((pos + count - 1) / page_size - first_page) + 1;
+
+        read_pages(
+            reinterpret_cast<unsigned char*>(dst_buff_) + offset,
+            count, pos, first_page, page_size, indexes, i_begin, i_end);
+
+        func_(part_);
+    });
+}
+
+
+std::future<void> db_1cd_83::object::read_async(
+    void* dst_buff_,
+    std::size_t count_, object::size_type pos_,
+    workers::background& thread_)
+{
+    std::vector<pages::index_type> indexes;
+    const pages::index_type first_page = interval_pages(count_, pos_, indexes);
+    const std::size_t page_size = pages_iface.page_size();
+
+    return thread_.run(
+        [this, dst_buff_, count_, pos_, first_page, page_size, indexes = std::move(indexes)]()
+        {
+            read_pages(dst_buff_, count_, pos_, first_page, page_size, indexes, 0, indexes.size());
+        });
+}
+
+
 db_1cd_83::root::root(pages& pages_) :
     blob_iface(pages_, 2)
 {
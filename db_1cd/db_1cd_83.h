@@ -18,6 +18,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <future>
+#include <functional>
 #include <cassert>
 #include <typeinfo>
 
@@ -66,6 +69,32 @@ public:
         pages::index_type page_num_to_index(pages::index_type page_num_);
         pages::index_type page_num_to_index_lite(pages::index_type page_num_) const;
 
+        pages::index_type page_index(pages::index_type page_num_)
+        {
+            auto* hdr = reinterpret_cast<const obj_hdr*>(hdr_page.data());
+            return
+                hdr->pmt_type == 0x01 ?
+                page_num_to_index(page_num_) :
+                page_num_to_index_lite(page_num_);
+        }
+
+        void check_interval(std::size_t count_, object::size_type pos_) const;
+
+        // Indexes of the pages with interval (placement tables are read
+        // through the pages cache). Returns number of the first page.
+        pages::index_type interval_pages(
+            std::size_t count_, object::size_type pos_,
+            std::vector<pages::index_type>& indexes_);
+
+        // Reads pages [i_begin_, i_end_) of 'interval_pages()' result by
+        // 'pages::read_direct()'. Thread-safe.
+        void read_pages(
+            void* dst_buff_,
+            std::size_t count_, object::size_type pos_,
+            pages::index_type first_page_, std::size_t page_size_,
+            const std::vector<pages::index_type>& indexes_,
+            std::size_t i_begin_, std::size_t i_end_) const;
+
     public:
         object(pages& pages_, pages::index_type index_);
 
@@ -75,9 +104,56 @@ public:
             return hdr->length;
         }
 
+        std::size_t page_size() const noexcept
+        {
+            return pages_iface.page_size();
+        }
+
+        // Interval must be inside one page. Pointer valid until next access to pages.
+        const void* view(std::size_t count_, object::size_type pos_);
+
         void read(
             void* dst_buff_,
             std::size_t count_, object::size_type pos_);
+
+        // Parallel read by chunks. Doesn't use the pages cache.
+        void read(
+            void* dst_buff_,
+            std::size_t count_, object::size_type pos_,
+            workers::pool& workers_);
+
+        struct interval
+        {
+            void* dst_buff = nullptr;
+            std::size_t count = 0;
+            object::size_type pos = 0;
+        };
+
+        // Same for several intervals: chunks of all intervals are read by one
+        // job of 'workers_', so small intervals are read in parallel too.
+        void read(
+            const std::vector<interval>& intervals_,
+            workers::pool& workers_);
+
+        // Parallel read by parts of 'part_size_' bytes: task of 'workers_'
+        // reads its part and calls 'func_(part)' at once, so processing of
+        // the part overlaps reading of others. Doesn't use the pages cache.
+        // Parts should be page-aligned, otherwise boundary pages are readed
+        // by both tasks.
+        void read_parts(
+            void* dst_buff_,
+            std::size_t count_, object::size_type pos_,
+            std::size_t part_size_,
+            workers::pool& workers_,
+            const std::function<void(std::size_t)>& func_);
+
+        // Read by 'thread_', completion (and errors) - by result. Doesn't
+        // use the pages cache, so the object can be used while reading.
+        // Buffer must exist until the end of reading.
+        std::future<void> read_async(
+            void* dst_buff_,
+            std::size_t count_, object::size_type pos_,
+            workers::background& thread_);
     };
 
 
@@ -19,6 +19,32 @@
 #include <regex>
 
 #include "db_1cd_8x.h"
+#include "rfc1951.h"
+#include "utf8.h"
+
+
+namespace
+{
+
+    // Event to wait for the overlapped reads of the thread.
+    HANDLE read_event() noexcept
+    {
+        struct holder
+        {
+            HANDLE handle = ::CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+            ~holder()
+            {
+                if (handle != nullptr)
+                    ::CloseHandle(handle);
+            }
+        };
+
+        thread_local holder event;
+        return event.handle;
+    }
+
+}
 
 
 std::string db_1cd_8x::file::error::to_string() const
@@ -48,7 +74,7 @@ db_1cd_8x::file::open(const std::wstring& path_name_)
         FILE_SHARE_READ,
         nullptr,
         OPEN_EXISTING,
-        FILE_FLAG_RANDOM_ACCESS,
+        FILE_FLAG_RANDOM_ACCESS | FILE_FLAG_OVERLAPPED,     // Concurrent reads are not serialized by system.
         nullptr);
 
     if (file_handle == INVALID_HANDLE_VALUE)
@@ -76,28 +102,35 @@ db_1cd_8x::file::error
 db_1cd_8x::file::read(void* dst_buff_, std::size_t count_, file::size_type pos_) const
 {
     assert(is_valid());                                     // File not opened.
+    assert(count_ <= std::numeric_limits<DWORD>::max());    // Limitation of the one request size.
 
-    LARGE_INTEGER li_pos = { 0 };
-    li_pos.QuadPart = pos_;
+    OVERLAPPED ovl = { 0 };                                 // Positional read: file pointer not shared
+    ovl.Offset = static_cast<DWORD>(pos_);                  // between concurrent calls.
+    ovl.OffsetHigh = static_cast<DWORD>(pos_ >> 32);
+    ovl.hEvent = read_event();                              // Own event: other reads of the handle don't signal it.
 
-    if (!::SetFilePointerEx(file_handle, li_pos, &li_pos, FILE_BEGIN))
-    {
+    if (ovl.hEvent == nullptr)
         return error(::GetLastError());
-    }
-
-    assert(count_ <= std::numeric_limits<DWORD>::max());    // Limitation of the one request size.
-
-    DWORD readed_size = 0;
 
     if (!::ReadFile(
         file_handle, dst_buff_,
-        static_cast<DWORD>(count_), &readed_size,
-        nullptr) ||
-        readed_size != count_)
+        static_cast<DWORD>(count_), nullptr,
+        &ovl))
     {
-        return error(::GetLastError());
+        const DWORD le = ::GetLastError();
+
+        if (le != ERROR_IO_PENDING)
+            return error(le);
     }
-    
+
+    DWORD readed_size = 0;
+
+    if (!::GetOverlappedResult(file_handle, &ovl, &readed_size, TRUE))
+        return error(::GetLastError());
+
+    if (readed_size != count_)
+        return error(ERROR_HANDLE_EOF);
+
     return {};
 }
 
@@ -275,13 +308,389 @@ const void* db_1cd_8x::pages::view(
 }
 
 
+void db_1cd_8x::pages::read_direct(
+    void* dst_buff_,
+    pages::index_type index_,
+    std::size_t count_, std::size_t pos_) const
+{
+    assert(file_iface.is_valid());                          // File not opened (cache is not touched).
+
+    if (index_ == 0 ||
+        index_ >= db_hdr.length)
+    {
+        throw exception(
+            "Invalid page index to read.");
+    }
+
+    const file::size_type pos_in_file =
+        static_cast<file::size_type>(db_hdr.page_size) * index_ + pos_;
+    const file::size_type file_size =
+        static_cast<file::size_type>(db_hdr.page_size) * db_hdr.length;
+
+    if (pos_in_file >= file_size ||
+        count_ > (file_size - pos_in_file))
+    {
+        throw exception(
+            "Requested data interval to read exceeds database size.");
+    }
+
+    const file::error fe =
+        file_iface.read(dst_buff_, count_, pos_in_file);
+
+    if (!fe)
+    {
+        throw exception(std::string(
+            "Error while reading pages from file: ") +
+            fe.to_string());
+    }
+}
+
+
+db_1cd_8x::blob_base::inflater::inflater()
+{
+    std::memset(&strm, 0, sizeof(strm));
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    const int res = inflateInit2(&strm, -MAX_WBITS);
+
+    if (res != Z_OK)
+    {
+        throw exception(std::string(
+            "ZLIB error code: ") + std::to_string(res));
+    }
+}
+
+
+db_1cd_8x::blob_base::inflater::~inflater()
+{
+    inflateEnd(&strm);
+}
+
+
+void db_1cd_8x::blob_base::inflater::reset()
+{
+    const int res = inflateReset(&strm);
+
+    if (res != Z_OK)
+    {
+        throw exception(std::string(
+            "ZLIB error code: ") + std::to_string(res));
+    }
+
+    stream_end = false;
+}
+
+
+std::size_t db_1cd_8x::blob_base::inflater::inflate(
+    const void* src_, std::size_t src_size_,
+    void* dst_buff_, std::size_t dst_size_,
+    std::size_t& produced_)
+{
+    produced_ = 0;
+
+    if (stream_end)
+        return 0;
+
+    constexpr std::size_t max_size = std::numeric_limits<uInt>::max();   // ZLIB internal limitation.
+
+    strm.next_in = reinterpret_cast<const Bytef*>(src_);
+    strm.avail_in = static_cast<uInt>(std::min(src_size_, max_size));
+    strm.next_out = reinterpret_cast<Bytef*>(dst_buff_);
+    strm.avail_out = static_cast<uInt>(std::min(dst_size_, max_size));
+
+    const uInt avail_in = strm.avail_in;
+    const uInt avail_out = strm.avail_out;
+
+    const int res = ::inflate(&strm, Z_NO_FLUSH);
+
+    if (res == Z_STREAM_END)
+        stream_end = true;
+    else if (res != Z_OK && res != Z_BUF_ERROR)             // Z_BUF_ERROR - no progress possible now.
+    {
+        throw exception(std::string(
+            "ZLIB error code: ") + std::to_string(res));
+    }
+
+    produced_ = avail_out - strm.avail_out;
+    return avail_in - strm.avail_in;
+}
+
+
+std::vector<std::unique_ptr<db_1cd_8x::blob_base::inflater>>&
+db_1cd_8x::blob_base::inflater::pooled::free_list()
+{
+    thread_local std::vector<std::unique_ptr<inflater>> result;
+    return result;
+}
+
+
+db_1cd_8x::blob_base::inflater::pooled::pooled()
+{
+    auto& streams = free_list();
+
+    if (streams.empty())
+    {
+        strm = std::make_unique<inflater>();
+    }
+    else
+    {
+        strm = std::move(streams.back());
+        streams.pop_back();
+    }
+}
+
+
+db_1cd_8x::blob_base::inflater::pooled::~pooled()
+{
+    try
+    {
+        auto& streams = free_list();
+
+        if (streams.size() < max_pooled)
+        {
+            strm->reset();
+            streams.push_back(std::move(strm));
+        }
+    }
+    catch (...)
+    {
+        // Stream not returned to pool - simply destroyed.
+    }
+}
+
+
+bool db_1cd_8x::blob_base::zlib_engine::decode(
+    const void* src_, std::size_t src_size_,
+    void* dst_buff_, std::size_t dst_size_,
+    std::size_t& produced_) const
+{
+    inflater::pooled strm;
+
+    const std::size_t consumed = strm->inflate(
+        src_, src_size_,
+        dst_buff_, dst_size_,
+        produced_);
+
+    if (strm->finished())
+        return true;
+
+    if (produced_ == dst_size_)
+    {
+        // Buffer is full. Possible only end of the stream left (exact size).
+        std::size_t tail = 0;
+        strm->inflate(
+            reinterpret_cast<const unsigned char*>(src_) + consumed, src_size_ - consumed,
+            reinterpret_cast<unsigned char*>(dst_buff_) + produced_, 0,
+            tail);
+
+        return strm->finished();
+    }
+
+    throw exception(
+        "Data flow ended before it was decompressed by ZLIB.");
+}
+
+
+bool db_1cd_8x::blob_base::fast_engine::decode(
+    const void* src_, std::size_t src_size_,
+    void* dst_buff_, std::size_t dst_size_,
+    std::size_t& produced_) const
+{
+    std::size_t src_used = 0;
+
+    switch (rfc1951::decode(src_, src_size_, dst_buff_, dst_size_, src_used, produced_))
+    {
+    case rfc1951::status::ok:
+        return true;
+
+    case rfc1951::status::dst_overflow:
+        produced_ = 0;
+        return false;
+
+    case rfc1951::status::src_end:
+        throw exception(
+            "Data flow ended before it was decompressed.");
+
+    default:
+        throw exception(
+            "Invalid format of compressed data.");
+    }
+}
+
+
+const db_1cd_8x::blob_base::inflate_engine& db_1cd_8x::blob_base::default_engine() noexcept
+{
+    static const fast_engine engine;
+    return engine;
+}
+
+
+db_1cd_8x::blob_base::spilled::spilled()
+{
+    std::wstring path(MAX_PATH + 1, L'\0');
+    const DWORD path_len = ::GetTempPathW(static_cast<DWORD>(path.size()), &path[0]);
+
+    if (path_len == 0 || path_len > path.size())
+    {
+        throw exception(std::string(
+            "Error while getting path of temporary files: ") +
+            file::error(::GetLastError()).to_string());
+    }
+
+    std::wstring name(MAX_PATH + 1, L'\0');
+
+    if (::GetTempFileNameW(path.c_str(), L"1cd", 0, &name[0]) == 0)
+    {
+        throw exception(std::string(
+            "Error while creating temporary file name: ") +
+            file::error(::GetLastError()).to_string());
+    }
+
+    file_handle = ::CreateFileW(
+        name.c_str(),
+        GENERIC_READ | GENERIC_WRITE,
+        0,
+        nullptr,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+        nullptr);
+
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        throw exception(std::string(
+            "Error while creating temporary file: ") +
+            file::error(::GetLastError()).to_string());
+    }
+}
+
+
+db_1cd_8x::blob_base::spilled::~spilled()
+{
+    if (mapped != nullptr)
+        ::UnmapViewOfFile(mapped);
+
+    if (mapping_handle != nullptr)
+        ::CloseHandle(mapping_handle);
+
+    if (file_handle != INVALID_HANDLE_VALUE)
+        ::CloseHandle(file_handle);
+}
+
+
+void db_1cd_8x::blob_base::spilled::write(const void* src_, std::size_t count_)
+{
+    assert(mapped == nullptr);                              // File already mapped.
+
+    auto* src = reinterpret_cast<const unsigned char*>(src_);
+
+    while (count_ != 0)
+    {
+        const auto to_write = static_cast<DWORD>(
+            std::min<std::size_t>(count_, std::numeric_limits<DWORD>::max()));
+        DWORD written = 0;
+
+        if (!::WriteFile(file_handle, src, to_write, &written, nullptr) ||
+            written != to_write)
+        {
+            throw exception(std::string(
+                "Error while writing temporary file: ") +
+                file::error(::GetLastError()).to_string());
+        }
+
+        src += to_write;
+        count_ -= to_write;
+        length += to_write;
+    }
+}
+
+
+void db_1cd_8x::blob_base::spilled::map()
+{
+    assert(mapped == nullptr);                              // File already mapped.
+
+    if (length == 0)                                        // Empty file can't be mapped.
+        return;
+
+    mapping_handle = ::CreateFileMappingW(
+        file_handle, nullptr,
+        PAGE_READONLY, 0, 0,
+        nullptr);
+
+    if (mapping_handle == nullptr)
+    {
+        throw exception(std::string(
+            "Error while mapping temporary file: ") +
+            file::error(::GetLastError()).to_string());
+    }
+
+    mapped = reinterpret_cast<const unsigned char*>(
+        ::MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if (mapped == nullptr)
+    {
+        throw exception(std::string(
+            "Error while mapping temporary file: ") +
+            file::error(::GetLastError()).to_string());
+    }
+}
+
+
+void db_1cd_8x::blob_base::bounded_value::append(const void* src_, std::size_t count_)
+{
+    if (!file &&
+        count_ > threshold - std::min(threshold, memory.size()))
+    {
+        // Value too large for memory - move it to file.
+        file = std::make_unique<spilled>();
+        file->write(memory.data(), memory.size());
+
+        memory.clear();
+        memory.shrink_to_fit();
+    }
+
+    if (file)
+    {
+        file->write(src_, count_);
+    }
+    else
+    {
+        auto* src = reinterpret_cast<const unsigned char*>(src_);
+        memory.insert(memory.end(), src, src + count_);
+    }
+}
+
+
+void db_1cd_8x::blob_base::bounded_value::finish()
+{
+    if (file)
+        file->map();
+}
+
+
 db_1cd_8x::pages::buffer_type db_1cd_8x::blob_base::decompress(
-    const pages::buffer_type& src_, std::size_t max_size_)
+    const pages::buffer_type& src_,
+    std::size_t max_size_, std::size_t size_hint_,
+    const inflate_engine* engine_)
 {
     pages::buffer_type dst;
+    decompress(src_, dst, max_size_, size_hint_, engine_);
+
+    return dst;
+}
+
+
+void db_1cd_8x::blob_base::decompress(
+    const pages::buffer_type& src_,
+    pages::buffer_type& dst_,
+    std::size_t max_size_, std::size_t size_hint_,
+    const inflate_engine* engine_)
+{
+    dst_.clear();
 
     if (src_.size() == 0)
-        return dst;
+        return;
 
     if (max_size_ > std::numeric_limits<uInt>::max())       // ZLIB internal limitation.
         max_size_ = std::numeric_limits<uInt>::max();
@@ -292,79 +701,81 @@ db_1cd_8x::pages::buffer_type db_1cd_8x::blob_base::decompress(
             "Size of data to decompress by ZLIB too large.");
     }
 
-    dst.resize(src_.size());
-
-    z_stream strm = { 0 };
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-    strm.opaque = Z_NULL;
-    strm.total_in = 0;
-    strm.avail_in = static_cast<uInt>(src_.size());
-    strm.next_in = src_.data();
-    strm.total_out = 0;
-    strm.avail_out = static_cast<uInt>(dst.size());
-    strm.next_out = dst.data();
-
-    try
+    if (size_hint_ != 0)                                    // Size known - decode at once.
     {
-        int res = inflateInit2(&strm, -MAX_WBITS);
+        const inflate_engine& engine = engine_ ? *engine_ : default_engine();
+        std::size_t produced = 0;
 
-        if (res != Z_OK)
-            goto zlib_error;
+        dst_.resize(std::min(size_hint_, max_size_));
 
-        do
+        if (engine.decode(src_.data(), src_.size(), dst_.data(), dst_.size(), produced))
         {
-            res = inflate(&strm, Z_NO_FLUSH);
+            dst_.resize(produced);
+            return;
+        }
+    }
 
-            if (res == Z_STREAM_END)
-            {
-                res = inflateEnd(&strm);
+    dst_.resize(std::min(std::max(src_.size(), size_hint_), max_size_));
 
-                if (res != Z_OK)
-                    goto zlib_error;
+    inflater::pooled strm;
+    std::size_t src_pos = 0;
+    std::size_t dst_pos = 0;
 
-                dst.resize(strm.total_out);
-                return dst;
-            }
-            else if (res != Z_OK)
-                goto zlib_error;
+    for (;;)
+    {
+        std::size_t produced = 0;
+        const std::size_t consumed = strm->inflate(
+            src_.data() + src_pos, src_.size() - src_pos,
+            dst_.data() + dst_pos, dst_.size() - dst_pos,
+            produced);
+
+        src_pos += consumed;
+        dst_pos += produced;
 
-            strm.avail_in = static_cast<uInt>(src_.size() - strm.total_in);
-            strm.next_in = src_.data() + strm.total_in;
+        if (strm->finished())
+            break;
+
+        if (dst_pos != dst_.size())
+        {
+            if (src_pos == src_.size())
+            {
+                throw exception(
+                    "Data flow ended before it was decompressed by ZLIB.");
+            }
 
-            if (dst.size() >= max_size_)
+            if (consumed == 0 && produced == 0)
             {
                 throw exception(
-                    "Decompressed by ZLIB data too large.");
+                    "ZLIB doesn't process data to decompress.");
             }
 
-            const std::size_t max_increment = max_size_ - dst.size();
-            
-            if (max_increment < dst.size())
-                dst.resize(dst.size() + max_increment);
-            else
-                dst.resize(dst.size() * 2);
+            continue;
+        }
 
-            strm.avail_out = static_cast<uInt>(dst.size() - strm.total_out);
-            strm.next_out = dst.data() + strm.total_out;
-        } while (strm.avail_in != 0);
+        // Buffer is full. Possible only end of the stream left (exact size hint).
+        src_pos += strm->inflate(
+            src_.data() + src_pos, src_.size() - src_pos,
+            dst_.data() + dst_pos, 0,
+            produced);
 
-        throw exception(
-            "Data flow ended before it was decompressed by ZLIB.");
+        if (strm->finished())
+            break;
 
-    zlib_error:
-        throw exception(std::string(
-            "ZLIB error code: ") + std::to_string(res));
-    }
-    catch (...)
-    {
-        inflateEnd(&strm);
-        throw;
+        if (dst_.size() >= max_size_)
+        {
+            throw exception(
+                "Decompressed by ZLIB data too large.");
+        }
+
+        const std::size_t max_increment = max_size_ - dst_.size();
+        dst_.resize(dst_.size() + std::min(dst_.size(), max_increment));
     }
+
+    dst_.resize(dst_pos);
 }
 
 
-std::wstring db_1cd_8x::blob_base::utf8to16(const pages::buffer_type& src_)
+std::wstring db_1cd_8x::blob_base::utf8to16(const pages::buffer_type& src_, bool strict_)
 {
     std::size_t src_size = src_.size();
 
@@ -382,37 +793,34 @@ std::wstring db_1cd_8x::blob_base::utf8to16(const pages::buffer_type& src_)
 
     src_size -= 3;
 
-    if (src_size > std::numeric_limits<int>::max())
-    {
-        throw exception(
-            "Length of source string to conversion from UTF-8 to UTF-16 too large.");
-    }
+    std::size_t size = 0;
+    std::wstring result;
 
-    auto src_ptr = reinterpret_cast<LPCCH>(&src_[3]);
+    // One pass: UTF-16 string is not longer than UTF-8 source.
+    if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+    {
+        result.resize(src_size);
 
-    int size = ::MultiByteToWideChar(
-        CP_UTF8, 0,
-        src_ptr, static_cast<int>(src_size),
-        nullptr, 0);
+        if (!utf8::to_utf16(&src_[3], src_size, reinterpret_cast<char16_t*>(&result[0]), size, strict_) && strict_)
+        {
+            throw exception(
+                "Error while string conversion UTF-8 to UTF-16.");
+        }
 
-    if (size == 0)
-    {
-        throw exception(
-            "Error while UTF-16 string size calculation.");
+        result.resize(size);
     }
+    else
+    {
+        std::u16string tmp;
+        tmp.resize(src_size);
 
-    std::wstring result;
-    result.resize(size);
-
-    size = ::MultiByteToWideChar(
-        CP_UTF8, 0,
-        src_ptr, static_cast<int>(src_size),
-        &result[0], static_cast<int>(result.size()));
+        if (!utf8::to_utf16(&src_[3], src_size, &tmp[0], size, strict_) && strict_)
+        {
+            throw exception(
+                "Error while string conversion UTF-8 to UTF-16.");
+        }
 
-    if (size != result.size())
-    {
-        throw exception(
-            "Error while string conversion UTF-8 to UTF-16.");
+        result.assign(tmp.begin(), tmp.begin() + size);
     }
 
     return result;
@@ -433,13 +841,20 @@ db_1cd_8x::field::binary::binary(
 }
 
 
+db_1cd_8x::field::boolean::value_type
+db_1cd_8x::field::boolean::get(const void* buff_) noexcept
+{
+    return *reinterpret_cast<const char*>(buff_) == 0 ? false : true;
+}
+
+
 db_1cd_8x::field::boolean::boolean(
     const fparams& params_, const void* buff_, std::size_t size_) :
     any(params_)
 {
     assert(size_ == size(params.length));                   // Buffer size not equal field length
 
-    exists = *reinterpret_cast<const char*>(buff_) == 0 ? false : true;
+    exists = get(buff_);
 }
 
 
@@ -457,102 +872,291 @@ db_1cd_8x::field::digit::digit(
 }
 
 
-db_1cd_8x::field::str_fix::str_fix(
-    const fparams& params_, const void* buff_, std::size_t size_) :
-    any(params_)
+std::int64_t db_1cd_8x::field::digit::to_int64() const
 {
-    assert(size_ == size(params.length));                   // Buffer size not equal field length
+    if (params.length > bcd::max_int64_digits)
+    {
+        throw exception(
+            "Digit length exceeds 64-bit integer.");
+    }
 
-    std::wstring tmp(
-        reinterpret_cast<const wchar_t*>(buff_),
-        this->params.length);
+    return bcd::to_int64(exists.value().data(), params.length);
+}
 
-    exists = std::move(tmp);
+
+bcd::int128 db_1cd_8x::field::digit::to_int128() const
+{
+    if (params.length > bcd::max_int128_digits)
+    {
+        throw exception(
+            "Digit length exceeds 128-bit integer.");
+    }
+
+    return bcd::to_int128(exists.value().data(), params.length);
 }
 
 
-db_1cd_8x::field::str_var::str_var(
+double db_1cd_8x::field::digit::to_double() const
+{
+    return bcd::to_double(exists.value().data(), params.length, params.precision);
+}
+
+
+// Strings in records are UTF-16 independently of 'wchar_t' size.
+static std::wstring to_wstring(std::u16string_view src_)
+{
+    if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+        return std::wstring(reinterpret_cast<const wchar_t*>(src_.data()), src_.size());
+    else
+        return std::wstring(src_.begin(), src_.end());
+}
+
+
+db_1cd_8x::field::str_fix::view_type
+db_1cd_8x::field::str_fix::view(const void* buff_, std::size_t size_) noexcept
+{
+    view_type result(
+        reinterpret_cast<const char16_t*>(buff_),
+        size_ / sizeof(char16_t));
+
+    const auto last = result.find_last_not_of(u' ');
+    return result.substr(0, last == view_type::npos ? 0 : last + 1);
+}
+
+
+db_1cd_8x::field::str_fix::str_fix(
     const fparams& params_, const void* buff_, std::size_t size_) :
     any(params_)
 {
     assert(size_ == size(params.length));                   // Buffer size not equal field length
 
+    exists = to_wstring(view_type(
+        reinterpret_cast<const char16_t*>(buff_),
+        this->params.length));
+}
+
+
+db_1cd_8x::field::str_var::view_type
+db_1cd_8x::field::str_var::view(const void* buff_, std::size_t size_)
+{
     std::uint16_t real_len = 0;
     buff_ = mem_get(buff_, real_len);
 
-    if (real_len > params.length)
+    if (real_len > (size_ - sizeof(real_len)) / sizeof(char16_t))
     {
         throw exception(
             "String length stored in table record more of field size.");
     }
 
-    std::wstring tmp(
-        reinterpret_cast<const wchar_t*>(buff_),
+    return view_type(
+        reinterpret_cast<const char16_t*>(buff_),
         real_len);
-
-    exists = std::move(tmp);
 }
 
 
-db_1cd_8x::field::version::version(
+db_1cd_8x::field::str_var::str_var(
     const fparams& params_, const void* buff_, std::size_t size_) :
     any(params_)
 {
     assert(size_ == size(params.length));                   // Buffer size not equal field length
 
+    exists = to_wstring(view(buff_, size_));
+}
+
+
+db_1cd_8x::field::version::value_type
+db_1cd_8x::field::version::get(const void* buff_) noexcept
+{
     value_type tmp;
     buff_ = mem_get(buff_, tmp.v1);
     buff_ = mem_get(buff_, tmp.v2);
     buff_ = mem_get(buff_, tmp.v3);
     buff_ = mem_get(buff_, tmp.v4);
 
-    exists = std::move(tmp);
+    return tmp;
 }
 
 
-db_1cd_8x::field::str_blob::str_blob(
+db_1cd_8x::field::version::version(
     const fparams& params_, const void* buff_, std::size_t size_) :
     any(params_)
 {
     assert(size_ == size(params.length));                   // Buffer size not equal field length
 
+    exists = get(buff_);
+}
+
+
+db_1cd_8x::field::str_blob::value_type
+db_1cd_8x::field::str_blob::get(const void* buff_) noexcept
+{
     value_type tmp;
     buff_ = mem_get(buff_, tmp.index);
     buff_ = mem_get(buff_, tmp.size);
 
-    exists = std::move(tmp);
+    return tmp;
 }
 
 
-db_1cd_8x::field::bin_blob::bin_blob(
+db_1cd_8x::field::str_blob::str_blob(
     const fparams& params_, const void* buff_, std::size_t size_) :
     any(params_)
 {
     assert(size_ == size(params.length));                   // Buffer size not equal field length
 
+    exists = get(buff_);
+}
+
+
+db_1cd_8x::field::bin_blob::value_type
+db_1cd_8x::field::bin_blob::get(const void* buff_) noexcept
+{
     value_type tmp;
     buff_ = mem_get(buff_, tmp.index);
     buff_ = mem_get(buff_, tmp.size);
 
-    exists = std::move(tmp);
+    return tmp;
 }
 
 
-db_1cd_8x::field::datetime::datetime(
+db_1cd_8x::field::bin_blob::bin_blob(
     const fparams& params_, const void* buff_, std::size_t size_) :
     any(params_)
 {
     assert(size_ == size(params.length));                   // Buffer size not equal field length
 
+    exists = get(buff_);
+}
+
+
+db_1cd_8x::field::datetime::value_type
+db_1cd_8x::field::datetime::get(const void* buff_) noexcept
+{
+    const auto* src = static_cast<const unsigned char*>(buff_);
+    const auto pair = [src](std::size_t i_)                 // Two digits of the byte.
+    {
+        return static_cast<std::uint8_t>((src[i_] >> 4) * 10 + (src[i_] & 0x0F));
+    };
+
     value_type tmp;
-    buff_ = mem_get(buff_, tmp.year);
-    buff_ = mem_get(buff_, tmp.month);
-    buff_ = mem_get(buff_, tmp.day);
-    buff_ = mem_get(buff_, tmp.hour);
-    buff_ = mem_get(buff_, tmp.minute);
-    buff_ = mem_get(buff_, tmp.second);
+    tmp.year = static_cast<std::uint16_t>(pair(0) * 100 + pair(1));
+    tmp.month = pair(2);
+    tmp.day = pair(3);
+    tmp.hour = pair(4);
+    tmp.minute = pair(5);
+    tmp.second = pair(6);
+
+    return tmp;
+}
 
-    exists = std::move(tmp);
+
+db_1cd_8x::field::datetime::stored_type
+db_1cd_8x::field::datetime::put(const value_type& value_) noexcept
+{
+    const auto pair = [](unsigned value_)
+    {
+        return static_cast<unsigned char>(((value_ / 10 % 10) << 4) | (value_ % 10));
+    };
+
+    return {
+        pair(value_.year / 100), pair(value_.year % 100),
+        pair(value_.month), pair(value_.day),
+        pair(value_.hour), pair(value_.minute), pair(value_.second) };
+}
+
+
+db_1cd_8x::field::datetime::datetime(
+    const fparams& params_, const void* buff_, std::size_t size_) :
+    any(params_)
+{
+    assert(size_ == size(params.length));                   // Buffer size not equal field length
+
+    exists = get(buff_);
+}
+
+
+static_assert(
+    std::is_trivially_copyable_v<db_1cd_8x::field::value>,
+    "Field value must be copied without constructors.");
+
+
+db_1cd_8x::field::value::value(ftype type_, const void* buff_, std::size_t size_) :
+    kind(type_),
+    exists(true)
+{
+    switch (kind)
+    {
+    case ftype::boolean:    data.flag = boolean::get(buff_); break;
+    case ftype::version:    data.ver = version::get(buff_); break;
+    case ftype::datetime:   data.date = datetime::get(buff_); break;
+    case ftype::str_blob:
+    case ftype::bin_blob:   data.blob = bin_blob::get(buff_); break;
+
+    case ftype::str_fix:
+    case ftype::str_var:
+    {
+        const auto str = kind == ftype::str_fix ?
+            str_fix::view(buff_, size_) :
+            str_var::view(buff_, size_);
+
+        data.text = str.data();
+        length = static_cast<std::uint32_t>(str.size());
+        break;
+    }
+
+    case ftype::binary:
+    case ftype::digit:
+        length = static_cast<std::uint32_t>(size_);
+
+        if (size_ <= inline_size)
+            std::memcpy(data.stored, buff_, size_);
+        else
+            data.bytes = static_cast<const unsigned char*>(buff_);
+
+        break;
+
+    default:
+        throw exception(
+            "Unknown table field type in table record.");
+    }
+}
+
+
+void db_1cd_8x::field::value::detach(std::pmr::memory_resource& memory_)
+{
+    if (!exists)
+        return;
+
+    switch (kind)
+    {
+    case ftype::str_fix:
+    case ftype::str_var:
+        if (length != 0)
+        {
+            auto* text = static_cast<char16_t*>(
+                memory_.allocate(length * sizeof(char16_t), alignof(char16_t)));
+
+            std::memcpy(text, data.text, length * sizeof(char16_t));
+            data.text = text;
+        }
+
+        break;
+
+    case ftype::binary:
+    case ftype::digit:
+        if (length > inline_size)
+        {
+            auto* bytes = static_cast<unsigned char*>(memory_.allocate(length, 1));
+
+            std::memcpy(bytes, data.bytes, length);
+            data.bytes = bytes;
+        }
+
+        break;
+
+    default:                                                // Value is stored inside.
+        break;
+    }
 }
 
 
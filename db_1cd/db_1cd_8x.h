@@ -16,7 +16,8 @@
 */
 /*
    This is basic solution like mini driver. Windows only: wchar_t, WinAPI,
-Microsoft Visual Studio 2019. No multithreading support.
+Microsoft Visual Studio 2019. No multithreading support, except methods which
+take 'workers::pool' (look 'workers.h').
    Supported format versions 8.2.14 and 8.3.8.
 
    This resources used in the development:
@@ -37,6 +38,9 @@ pages
    'read()' and 'view()'. The second is used for access to page in cache without
    copying data. Pointer returned by 'view()' invalidate after next call
    'read()' or 'view()'.
+   Method 'read_direct()' reads data from file bypassing the cache. It is
+   thread-safe and used by parallel reads. File is opened for overlapped I/O,
+   so reads from different threads are executed concurrently.
    One instance for both versions of the database.
 
 object
@@ -44,13 +48,37 @@ object
 
    Uses placement tables while access to data. This logic depends from version
    of database (differents formats).
+   Large intervals can be read in parallel by 'workers::pool': placement
+   tables are resolved by calling thread, then page-aligned chunks are read
+   by 'pages::read_direct()'. Method 'read_parts()' calls function for each
+   part right after its reading in the same task. Same way 'read_async()'
+   reads interval by background thread ('workers::background').
 
 blob
    Database stream that stores data outside tables: binary data and long UTF-8
    strings.
 
    Some data compressed by ZLIB algorithm. Implemented the data decompression
-   and conversion UTF-8 strings to UTF-16.
+   and conversion UTF-8 strings to UTF-16 (look 'utf8.h').
+   Decompression of the whole value is done by 'blob_base::inflate_engine'. If
+   size of the result is known, own decoder is used ('rfc1951.h'), it is faster
+   than ZLIB stream. ZLIB engine is the reference and fallback.
+   Chain of blocks is walked by pages: page of the object is viewed once and
+   next blocks on the same page are taken from it without new requests.
+   Large values can be read by parts with 'blob::reader' - memory usage not
+   depends from size of the value. Compressed values can be decompressed by
+   'blob::inflate()' on the fly: blocks are passed to ZLIB directly, data
+   returned by parts in buffer of the caller.
+   Large values can be readed by 'blob::get_bounded()': if value larger than
+   threshold, it is written to temporary file and mapped to memory.
+   Method 'blob::view()' returns value without copying, if it stored in one
+   block (most of short values).
+   Many values can be readed by 'blob::get_many()': chains are walked in order
+   of their placement in the object, optionally object pages are readed by
+   parallel tasks.
+   Decoded values can be cached in memory: enable it by 'blob::cache_limit()'
+   and use 'blob::get_data()' and 'blob::get_text()'. Cache uses LRU policy
+   with limit of values total size.
 
 field
    Describes database table fields.
@@ -61,6 +89,12 @@ field
    check the attribute 'exists.has_value()'.
    Some fields referenced to objects in BLOB. Which BLOB to use for reading
    data depends from table parameters.
+   Values of 'digit' fields are packed decimal numbers, they are decoded to
+   integers and 'double' by 'bcd.h'. Values of 'datetime' fields are packed
+   decimal 'YYYYMMDDhhmmss' too, they are converted to seconds (days) from
+   1970-01-01 and back by 'dates.h'.
+   Class 'field::value' holds value of any type without allocations and
+   virtual calls (used by 'records::decode_plan').
    'Fields' same as for both versions of the database.
 
 records
@@ -68,6 +102,37 @@ records
 
    Use 'seek()' to select the record (load from DB). Record can be deleted -
    check it before access to fields.
+   String fields can be accessed without copying by 'get_string()'.
+   For full scans use 'read_batch()': range of records is readed by one request
+   to buffer, fields are accessed by views of the records.
+   Method 'read_columns()' decodes selected fields of range of records to
+   arrays (one per field) with bitmaps of NULL values and not deleted records.
+   Method 'scan()' selects records by simple conditions ('records::condition'),
+   conditions are checked on data in buffer before creating any fields.
+   Deleted records of a batch are found at once by bitmap (look 'rows.h'), so
+   'read_columns()' and 'scan()' skip them without checks of each record.
+   Known tables can be described by 'records::schema': fields are checked once
+   on its creation, values are readed by fixed offsets.
+   Places of the fields in record are computed once on creation of 'records'
+   (names and other parameters are stored separately). Whole record or set of
+   fields can be decoded without copying by one loop ('records::decode_plan').
+   Values derived from records of a batch (copies of strings to keep after
+   the batch, 'std::pmr' containers) can be allocated in its memory
+   ('record_view::memory()', look 'arena.h'), it is freed at once by next
+   batch without heap calls.
+   Methods 'parallel_scan()' and 'parallel_collect()' split table to
+   partitions (about 1MB) processed by 'workers::pool'. The first calls
+   function from worker threads, the second returns results in order of
+   records.
+   With C++20 coroutines, method 'generate()' returns generator of live
+   records for range-for loop. Next batch is readed by background thread of
+   the generator ('read_async()') while records of the current batch are
+   processed. Reading isn't awaitable: if the batch isn't readed yet when
+   the loop comes to it, the consumer thread blocks until reading ends.
+   Example 'users_list' uses it (the project is built as C++20).
+   If records are bound to BLOB-object of the table, values of BLOB fields can
+   be accessed by 'get_blob()'. It returns handle, data is readed, decompressed
+   and converted only on access to it.
 
 table
    In this version desribes parameters only: name, set of fields and data
@@ -82,16 +147,30 @@ root
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <array>
 #include <map>
 #include <memory>
 #include <limits>
 #include <optional>
+#include <variant>
+#include <tuple>
+#include <iterator>
+#include <type_traits>
+#include <algorithm>
+#include <numeric>
 #include <stdexcept>
 #include <cassert>
 #include <typeinfo>
 
+#ifdef __cpp_impl_coroutine
+#include <coroutine>
+#include <future>
+#include <exception>
+#include <utility>
+#endif
+
 #define NOMINMAX
 #include <windows.h>
 
@@ -99,6 +178,11 @@ root
 #include "zlib.h"
 
 #include "cache.h"
+#include "workers.h"
+#include "rows.h"
+#include "bcd.h"
+#include "dates.h"
+#include "arena.h"
 
 
 class db_1cd_8x
@@ -299,6 +383,12 @@ public:
                 count_);
         }
 
+        // Interval may continue to the next pages of the file.
+        void read_direct(
+            void* dst_buff_,
+            pages::index_type index_,
+            std::size_t count_, std::size_t pos_) const;
+
         pages(std::size_t cached_) :
             cache_size(cached_),
             cache_queue(cached_)
@@ -318,10 +408,205 @@ private:
     class blob_base
     {
     public:
+        // Streaming decompression of the raw 'deflate' data by ZLIB.
+        class inflater
+        {
+        private:
+            z_stream strm;                                  // ZLIB stream state.
+            bool stream_end = false;                        // End of compressed data reached.
+
+        public:
+            bool finished() const noexcept
+            {
+                return stream_end;
+            }
+
+            void reset();
+
+            // Returns count of the used bytes from 'src_', 'produced_' - count of the bytes
+            // written to 'dst_buff_'. After the end of compressed data does nothing.
+            std::size_t inflate(
+                const void* src_, std::size_t src_size_,
+                void* dst_buff_, std::size_t dst_size_,
+                std::size_t& produced_);
+
+            // Stream from the pool of the current thread: ZLIB stream is initialized
+            // once and only reset between values. Returned to the pool on destroy.
+            class pooled
+            {
+            private:
+                static constexpr std::size_t max_pooled = 4;   // Ready streams kept by each thread.
+                static std::vector<std::unique_ptr<inflater>>& free_list();
+
+                std::unique_ptr<inflater> strm;
+
+            public:
+                inflater& operator*() const noexcept
+                {
+                    return *strm;
+                }
+
+                inflater* operator->() const noexcept
+                {
+                    return strm.get();
+                }
+
+                pooled();
+
+                pooled(const pooled&) = delete;
+                pooled(pooled&&) = delete;
+                pooled& operator=(const pooled&) = delete;
+                pooled& operator=(pooled&&) = delete;
+
+                ~pooled();
+            };
+
+            inflater();
+
+            inflater(const inflater&) = delete;
+            inflater(inflater&&) = delete;
+            inflater& operator=(const inflater&) = delete;
+            inflater& operator=(inflater&&) = delete;
+
+            ~inflater();
+        };
+
+        // Decoder of the whole raw 'deflate' data into buffer of known size.
+        class inflate_engine
+        {
+        public:
+            virtual const char* name() const noexcept = 0;
+
+            // Returns 'false' if size of 'dst_buff_' not enough for all data, 'produced_' -
+            // size of the result. Throws exception if data is invalid.
+            virtual bool decode(
+                const void* src_, std::size_t src_size_,
+                void* dst_buff_, std::size_t dst_size_,
+                std::size_t& produced_) const = 0;
+
+            virtual ~inflate_engine() = default;
+        };
+
+        // Reference engine: ZLIB (stream from the pool of the current thread).
+        class zlib_engine : public inflate_engine
+        {
+        public:
+            const char* name() const noexcept override
+            {
+                return "zlib";
+            }
+
+            bool decode(
+                const void* src_, std::size_t src_size_,
+                void* dst_buff_, std::size_t dst_size_,
+                std::size_t& produced_) const override;
+        };
+
+        // Own decoder without streaming state (look 'rfc1951.h').
+        class fast_engine : public inflate_engine
+        {
+        public:
+            const char* name() const noexcept override
+            {
+                return "rfc1951";
+            }
+
+            bool decode(
+                const void* src_, std::size_t src_size_,
+                void* dst_buff_, std::size_t dst_size_,
+                std::size_t& produced_) const override;
+        };
+
+        // Engine used by 'decompress()' when other not passed.
+        static const inflate_engine& default_engine() noexcept;
+
+        // Data in temporary file (deleted on close). After writing file is
+        // mapped to memory for reading.
+        class spilled
+        {
+        private:
+            HANDLE file_handle = INVALID_HANDLE_VALUE;      // WinAPI handle of the temporary file.
+            HANDLE mapping_handle = nullptr;                // ... of its mapping.
+            const unsigned char* mapped = nullptr;          // Mapped data (after 'map()').
+            std::size_t length = 0;                         // Size of written data (bytes).
+
+        public:
+            const unsigned char* data() const noexcept
+            {
+                return mapped;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return length;
+            }
+
+            void write(const void* src_, std::size_t count_);
+            void map();
+
+            spilled();
+
+            spilled(const spilled&) = delete;
+            spilled(spilled&&) = delete;
+            spilled& operator=(const spilled&) = delete;
+            spilled& operator=(spilled&&) = delete;
+
+            ~spilled();
+        };
+
+    public:
+        // Value stored in memory, if its size not above threshold, else - in
+        // temporary file (look 'blob::get_bounded()').
+        class bounded_value
+        {
+        private:
+            pages::buffer_type memory;                      // Small value.
+            std::unique_ptr<spilled> file;                  // Large value.
+            std::size_t threshold;                          // Limit of the value size in memory.
+
+        public:
+            bool is_spilled() const noexcept
+            {
+                return static_cast<bool>(file);
+            }
+
+            const unsigned char* data() const noexcept
+            {
+                return file ? file->data() : memory.data();
+            }
+
+            std::size_t size() const noexcept
+            {
+                return file ? file->size() : memory.size();
+            }
+
+            // Writing of the value by parts, then 'finish()' to access the data.
+            void append(const void* src_, std::size_t count_);
+            void finish();
+
+            bounded_value(std::size_t threshold_) : threshold(threshold_) {}
+        };
+
+    public:
+        // 'size_hint_' - expected size of decompressed data, if known. With the
+        // hint data is decoded at once by 'engine_' (default - 'default_engine()'),
+        // if the hint is too small - by ZLIB stream with growing buffer.
         static pages::buffer_type decompress(
             const pages::buffer_type& src_,
-            std::size_t max_size_ = std::numeric_limits<uInt>::max());
-        static std::wstring utf8to16(const pages::buffer_type& src_);
+            std::size_t max_size_ = std::numeric_limits<uInt>::max(),
+            std::size_t size_hint_ = 0,
+            const inflate_engine* engine_ = nullptr);
+
+        // Same, but reuses memory of 'dst_' (useful for many small values).
+        static void decompress(
+            const pages::buffer_type& src_,
+            pages::buffer_type& dst_,
+            std::size_t max_size_ = std::numeric_limits<uInt>::max(),
+            std::size_t size_hint_ = 0,
+            const inflate_engine* engine_ = nullptr);
+        // Invalid UTF-8 sequences are replaced by U+FFFD, 'strict_' -
+        // exception for them.
+        static std::wstring utf8to16(const pages::buffer_type& src_, bool strict_ = false);
     };
 
 
@@ -344,10 +629,165 @@ protected:
 #pragma pack(pop)
 
         Tobject_type obj_iface;                             // Interface of DB object to read blocks.
+        pages::buffer_type view_buff;                       // Data of the value returned by 'view()'.
+
+        // Cache of decoded values. Key - index of the value and 'decoded_kind'.
+        enum class decoded_kind : std::uint64_t
+        {
+            data = 0,
+            inflated_data,
+            text,
+            inflated_text
+        };
+
+        struct decoded_type
+        {
+            std::size_t stored_size;                        // Size of the value in BLOB (before decoding).
+
+            std::variant<
+                std::shared_ptr<const pages::buffer_type>,
+                std::shared_ptr<const std::wstring>> value;
+        };
+
+        static constexpr std::size_t decoded_overhead = 64; // Weight of the cache item without value.
+        std::unique_ptr<cache::weighted_lru<std::uint64_t, decoded_type>> decoded;
+
+        // Value from cache or 'decode_(get(index_, size_))'. Cached value is
+        // returned only if 'size_' is zero or equal to size of the stored value.
+        template <typename Tresult, typename Tfunc>
+        std::shared_ptr<const Tresult> get_decoded(
+            blob::index_type index_, std::size_t size_, decoded_kind kind_,
+            Tfunc&& decode_);
+
+        // Access to blocks of one chain with loop protection.
+        class chain
+        {
+        private:
+            Tobject_type& obj_iface;                        // Object with blocks.
+            const unsigned char* page = nullptr;            // Viewed page of the object.
+            blob::index_type page_num = 0;                  // Its number.
+            blob::index_type blk_count;                     // Blocks count in the object.
+            blob::index_type loop_prot;                     // Counter of the blocks left to loop detect.
+
+            const unsigned char* window_data = nullptr;     // Already readed part of the object.
+            typename Tobject_type::size_type window_pos = 0;    // Its position in the object.
+            std::size_t window_size = 0;                    // Its size.
+
+        public:
+            // Call after other access to pages - viewed page can be invalid.
+            void reset() noexcept
+            {
+                page = nullptr;
+            }
+
+            // Blocks inside the window are taken from it without access to pages.
+            void window(
+                const void* data_,
+                typename Tobject_type::size_type pos_, std::size_t size_) noexcept
+            {
+                window_data = reinterpret_cast<const unsigned char*>(data_);
+                window_pos = pos_;
+                window_size = size_;
+            }
+
+            const blob_blk& block(blob::index_type index_);
+            blob::index_type next(const blob_blk& block_);
+
+            chain(Tobject_type& obj_);
+        };
+
+        // Calls 'func_(data, length)' for each block of the chain. Data pointer
+        // is valid only inside call - don't access to pages from 'func_'.
+        template <typename Tfunc>
+        void walk(blob::index_type index_, Tfunc&& func_);
+
+        template <typename Tfunc>
+        void walk(chain& blocks_, blob::index_type index_, Tfunc&& func_);
+
+        pages::buffer_type collect(chain& blocks_, blob::index_type index_, std::size_t size_);
+
+    public:
+        // Reads value sequentially by parts, like 'std::istream::read()'.
+        // Between calls of 'read()' it is allowed to access to other objects.
+        class reader
+        {
+        private:
+            chain blocks;                                   // Blocks of the value.
+            blob::index_type index;                         // Current block (0 - end of the value).
+            std::size_t pos_in_block = 0;                   // Already readed bytes of current block.
+            std::size_t total = 0;                          // Already readed bytes of the value.
+            const std::size_t expected;                     // Expected size of the value or 0.
+
+        public:
+            bool eof() const noexcept
+            {
+                return index == 0;
+            }
+
+            std::size_t read(void* dst_buff_, std::size_t count_);
+
+            reader(blob& blob_, blob::index_type index_, std::size_t size_ = 0);
+        };
+
+    public:
+        struct view_type
+        {
+            const unsigned char* data = nullptr;
+            std::size_t size = 0;
+        };
 
     public:
         blob(pages& pages_, pages::index_type index_);
         pages::buffer_type get(blob::index_type index_, std::size_t size_ = 0);
+
+        // Value (decompressed if 'compressed_') with limited memory usage: value
+        // larger than 'threshold_' is written by parts to temporary file.
+        bounded_value get_bounded(
+            blob::index_type index_, std::size_t size_,
+            bool compressed_, std::size_t threshold_);
+
+        // Value without copying, if it stored in one block: data points to the page
+        // in cache and valid until next access to pages (like 'pages::view()').
+        // Other values are copied to the internal buffer, valid until next 'view()'.
+        view_type view(blob::index_type index_, std::size_t size_ = 0);
+
+        // Values in order of 'indexes_'. Chains are walked in order of their
+        // placement in the object, each value is readed once.
+        std::vector<pages::buffer_type> get_many(const std::vector<blob::index_type>& indexes_);
+
+        // Same, but windows of object pages with the values are readed by
+        // parallel tasks of 'workers_' (bypassing the cache). Values are
+        // sorted by order of object pages, not of the file pages.
+        std::vector<pages::buffer_type> get_many(
+            const std::vector<blob::index_type>& indexes_,
+            workers::pool& workers_);
+
+        // Enables cache of the values returned by 'get_data()' and 'get_text()',
+        // 'bytes_' - limit of memory used by cache. Zero - cache disabled (default).
+        void cache_limit(std::size_t bytes_);
+
+        // Same as 'get()', decompressed if 'compressed_'. Cached (look 'cache_limit()').
+        // 'expected_size_' - size of decompressed data, if known: it is passed
+        // to 'decompress()' as hint (database stores only size of compressed
+        // data - 'size_').
+        std::shared_ptr<const pages::buffer_type> get_data(
+            blob::index_type index_, std::size_t size_ = 0,
+            bool compressed_ = false, std::size_t expected_size_ = 0);
+
+        // UTF-8 string converted to UTF-16 (look 'utf8to16()'). Cached.
+        std::shared_ptr<const std::wstring> get_text(
+            blob::index_type index_, std::size_t size_ = 0,
+            bool compressed_ = false, std::size_t expected_size_ = 0);
+
+        // Decompresses value to 'dst_buff_' and calls 'func_(dst_buff_, size)' each
+        // time buffer filled and at the end of data. 'size_' - size of stored
+        // (compressed) value, checked if not zero.
+        template <typename Tfunc>
+        void inflate(
+            blob::index_type index_,
+            void* dst_buff_, std::size_t dst_size_,
+            Tfunc&& func_,
+            std::size_t size_ = 0);
     };
 
 
@@ -441,6 +881,9 @@ public:
                 return 1;
             }
 
+            // Value from record buffer (without NULL-flag).
+            static value_type get(const void* buff_) noexcept;
+
             static constexpr ftype type() noexcept
             {
                 return ftype::boolean;
@@ -469,20 +912,31 @@ public:
 
             digit(const fparams& params_) : any(params_) {}
             digit(const fparams& params_, const void* buff_, std::size_t size_);
+
+            // Value without decimal point: 'value / 10^precision' (look 'bcd.h').
+            // Value must not be NULL.
+            std::int64_t to_int64() const;
+            bcd::int128 to_int128() const;
+
+            double to_double() const;
         };
 
         class str_fix : public any
         {
         public:
             using value_type = std::wstring;                // Fixed-size string.
+            using view_type = std::u16string_view;          // String in record buffer.
             std::optional<value_type> exists;
 
         public:
             static constexpr std::size_t size(std::size_t length_) noexcept
             {
-                return length_ * sizeof(wchar_t);
+                return length_ * sizeof(char16_t);
             }
 
+            // Without trailing spaces.
+            static view_type view(const void* buff_, std::size_t size_) noexcept;
+
             static constexpr ftype type() noexcept
             {
                 return ftype::str_fix;
@@ -496,14 +950,17 @@ public:
         {
         public:
             using value_type = std::wstring;                // Basic string.
+            using view_type = std::u16string_view;          // String in record buffer.
             std::optional<value_type> exists;
 
         public:
             static constexpr std::size_t size(std::size_t length_) noexcept
             {
-                return length_ * sizeof(wchar_t) + 2;
+                return length_ * sizeof(char16_t) + 2;
             }
 
+            static view_type view(const void* buff_, std::size_t size_);
+
             static constexpr ftype type() noexcept
             {
                 return ftype::str_var;
@@ -531,6 +988,9 @@ public:
                 return 16;
             }
 
+            // Value from record buffer (without NULL-flag).
+            static value_type get(const void* buff_) noexcept;
+
             static constexpr ftype type() noexcept
             {
                 return ftype::version;
@@ -556,6 +1016,9 @@ public:
                 return 8;
             }
 
+            // Value from record buffer (without NULL-flag).
+            static value_type get(const void* buff_) noexcept;
+
             static constexpr ftype type() noexcept
             {
                 return ftype::str_blob;
@@ -581,6 +1044,9 @@ public:
                 return 8;
             }
 
+            // Value from record buffer (without NULL-flag).
+            static value_type get(const void* buff_) noexcept;
+
             static constexpr ftype type() noexcept
             {
                 return ftype::bin_blob;
@@ -604,12 +1070,22 @@ public:
             };
             std::optional<value_type> exists;
 
+            // Value in record: packed decimal 'YYYYMMDDhhmmss', two digits in
+            // byte. Order of the bytes is order of the values.
+            using stored_type = std::array<unsigned char, 7>;
+
         public:
             static constexpr std::size_t size(std::size_t length_) noexcept
             {
                 return 7;
             }
 
+            // Value from record buffer (without NULL-flag).
+            static value_type get(const void* buff_) noexcept;
+
+            // Value as stored in record.
+            static stored_type put(const value_type& value_) noexcept;
+
             static constexpr ftype type() noexcept
             {
                 return ftype::datetime;
@@ -618,6 +1094,100 @@ public:
             datetime(const fparams& params_) : any(params_) {}
             datetime(const fparams& params_, const void* buff_, std::size_t size_);
         };
+
+        // Value of any field type without heap and virtual calls. Trivially
+        // copyable: fixed-size values (and 'binary'/'digit' up to 16 bytes,
+        // as GUID) are stored inside, strings and longer data are pointers
+        // to the record buffer.
+        class value
+        {
+        public:
+            static constexpr std::size_t inline_size = 16;  // Max size of stored 'binary' and 'digit'.
+
+            struct bytes_type
+            {
+                const unsigned char* data = nullptr;
+                std::size_t size = 0;
+            };
+
+        private:
+            ftype kind = ftype::unknown;                    // Type of the field.
+            bool exists = false;                            // Not NULL.
+            std::uint32_t length = 0;                       // Length of string (chars) or data (bytes).
+
+            union data_type
+            {
+                bool flag;
+                version::value_type ver;
+                datetime::value_type date;
+                bin_blob::value_type blob;                  // 'str_blob' and 'bin_blob'.
+                const char16_t* text;                       // 'str_fix' and 'str_var'.
+                const unsigned char* bytes;                 // 'binary' and 'digit' longer 'inline_size'.
+                unsigned char stored[inline_size];          // 'binary' and 'digit' up to 'inline_size'.
+
+                data_type() noexcept : stored{} {}
+            } data;
+
+        public:
+            ftype type() const noexcept
+            {
+                return kind;
+            }
+
+            bool is_null() const noexcept
+            {
+                return !exists;
+            }
+
+            bool as_bool() const noexcept
+            {
+                assert(exists && kind == ftype::boolean);
+                return data.flag;
+            }
+
+            const version::value_type& as_version() const noexcept
+            {
+                assert(exists && kind == ftype::version);
+                return data.ver;
+            }
+
+            const datetime::value_type& as_datetime() const noexcept
+            {
+                assert(exists && kind == ftype::datetime);
+                return data.date;
+            }
+
+            const bin_blob::value_type& as_blob() const noexcept
+            {
+                assert(exists && (kind == ftype::str_blob || kind == ftype::bin_blob));
+                return data.blob;
+            }
+
+            // Same as 'records::get_string()'.
+            std::u16string_view as_string() const noexcept
+            {
+                assert(exists && (kind == ftype::str_fix || kind == ftype::str_var));
+                return std::u16string_view(data.text, length);
+            }
+
+            bytes_type as_bytes() const noexcept
+            {
+                assert(exists && (kind == ftype::binary || kind == ftype::digit));
+                return { length <= inline_size ? data.stored : data.bytes, length };
+            }
+
+            value() = default;
+
+            // NULL value of the type.
+            explicit value(ftype type_) noexcept : kind(type_) {}
+
+            // From record buffer (without NULL-flag).
+            value(ftype type_, const void* buff_, std::size_t size_);
+
+            // Copies string or data, which points to the record buffer, to
+            // 'memory_': value doesn't depend on the buffer anymore.
+            void detach(std::pmr::memory_resource& memory_);
+        };
     };
 
 
@@ -630,19 +1200,25 @@ protected:
         using index_type = std::uint32_t;
 
     private:
-        struct helper
+        // Place of the field value in record. Array of them is decode plan of
+        // the record: it is computed once and used by all readings of fields.
+        struct field_slot
         {
-            field::fparams params;                          // Field format description.
-            std::size_t shift = -1;                         // Shift of the field from begin of the record (bytes).
-            std::size_t size = 0;                           // Length of the field with special attributes.
+            std::uint32_t null_flag = 0;                    // Shift of NULL-flag in record.
+            std::uint32_t data = 0;                         // Shift of the value in record.
+            std::uint32_t size = 0;                         // Size of the value.
+            field::ftype type = field::ftype::unknown;      // Type of the value.
+            bool null_exists = false;                       // NULL-value allowed ?
         };
 
-        std::vector<helper> fields;                         // Set of data for fast search
-        std::map<std::wstring, field::index_type> indexes;  // of the field parameters.
+        std::vector<field_slot> slots;                      // Places of the fields (hot data).
+        std::vector<field::fparams> params;                 // Fields parameters (names and others).
+        std::map<std::wstring, field::index_type> indexes;  // Fields by names.
 
         std::size_t prepare_fields(const std::vector<field::fparams>& params_);
 
         Tobject_type obj_iface;                             // DB object to read table records.
+        std::unique_ptr<blob<Tobject_type>> blob_iface;     // BLOB-object of the table (optional).
         pages::buffer_type record;                          // Buffer that stores one table record after call 'seek()'.
         records::index_type records_count;                  // Records count in the table.
         std::optional<records::index_type> last_index;      // Index of the last sucesfully readed table record.
@@ -652,315 +1228,2492 @@ protected:
             return last_index.has_value();
         }
 
-    public:
-        records(
-            pages& pages_,
-            pages::index_type index_,
-            const std::vector<field::fparams>& params_);
-
-        records::index_type size() const noexcept
-        {
-            return records_count;
-        }
+        // Readed record after successful 'seek()'.
+        const unsigned char* current() const;
 
-        field::index_type field_index(const std::wstring& name_) const;
-        void seek(records::index_type index_);
-        bool is_deleted() const;
+        // Data of the field in 'record_' without NULL-flag. 'nullptr' - NULL.
+        const void* field_data(
+            const unsigned char* record_,
+            field::index_type index_, field::ftype type_,
+            std::size_t& size_) const;
 
         template <typename Tvalue_type>
-        Tvalue_type get_field(field::index_type index_) const;
-    };
+        Tvalue_type field_value(const unsigned char* record_, field::index_type index_) const;
 
+        std::optional<std::u16string_view> string_value(
+            const unsigned char* record_, field::index_type index_) const;
 
-public:
+        pages::buffer_type batch_buff;                      // Memory for records readed by 'read_batch()'.
+        arena::resource batch_arena;                        // Memory for values of the batch records.
+
+        // Reads records to 'batch_buff', 'count_' is reduced if table ends.
+        const unsigned char* read_raw(records::index_type first_, records::index_type& count_);
 
-    class table
-    {
     public:
-        struct params
+        // Value of BLOB field. Data is readed from BLOB only on access, so
+        // records skipped by filter don't cost BLOB reading. Valid while
+        // 'records' object exists.
+        class blob_value
         {
-            std::wstring name;                              // Table name.
-            std::vector<field::fparams> columns;            // Fields parameters.
-            bool record_lock = false;                       // Special flag (unknown purpose).
-            pages::index_type i_records = 0;                // Index of the object with table records.
-            pages::index_type i_blob = 0;                   // ... with long data.
-            pages::index_type i_indexes = 0;                // ... with indexes (not implemented).
+        private:
+            blob<Tobject_type>* blob_iface;                 // BLOB-object of the table.
+            typename blob<Tobject_type>::index_type index;  // Index of the first data block.
+            std::size_t length;                             // Size of the stored data (bytes).
+
+        public:
+            std::size_t size() const noexcept
+            {
+                return length;
+            }
+
+            // Look 'blob::view()'.
+            typename blob<Tobject_type>::view_type view() const;
+
+            // Look 'blob::get_data()' and 'blob::get_text()'. Stored size of
+            // the value ('bin_blob::value_type::size') is passed to them, it is
+            // checked while reading and is initial size of decompressed data.
+            // 'expected_size_' - size of decompressed data, if known.
+            std::shared_ptr<const pages::buffer_type> data(
+                bool compressed_ = false, std::size_t expected_size_ = 0) const;
+            std::shared_ptr<const std::wstring> text(
+                bool compressed_ = false, std::size_t expected_size_ = 0) const;
+
+            blob_value(
+                blob<Tobject_type>& blob_,
+                typename blob<Tobject_type>::index_type index_, std::size_t size_) :
+                blob_iface(&blob_),
+                index(index_),
+                length(size_)
+            {
+            }
         };
-    };
 
+        // Bit for each record of the range (64 records in one word).
+        using bitmap_type = std::vector<std::uint64_t>;
 
-protected:
+        static bool test(const bitmap_type& bits_, std::size_t i_) noexcept
+        {
+            return (bits_[i_ / 64] >> (i_ % 64)) & 1;
+        }
 
-    class root
-    {
-    public:
-        static std::wstring parse_name(const std::wstring& descr_);
-        static std::vector<field::fparams> parse_fields(const std::wstring& descr_);
-        static bool parse_lock(const std::wstring& descr_);
-        static std::array<pages::index_type, 3> parse_files(const std::wstring& descr_);
-        static table::params parse_params(const std::wstring& descr_);
-    };
+        // Record readed by 'read_batch()'. Valid until next 'read_batch()'.
+        class record_view
+        {
+        private:
+            const records* owner;                           // Table records with fields description.
+            const unsigned char* data;                      // Record in the batch buffer.
+            arena::resource* values_memory;                 // Memory of the batch or nullptr.
 
-};
+        public:
+            bool is_deleted() const noexcept
+            {
+                return data[0] == 1;
+            }
 
+            // Memory for values derived from records of the batch, it is
+            // freed at once by next 'read_batch()'. Not available in
+            // 'parallel_scan()'.
+            arena::resource& memory() const noexcept
+            {
+                assert(values_memory != nullptr);
+                return *values_memory;
+            }
 
-template <typename Tobject_type>
-db_1cd_8x::blob<Tobject_type>::blob(
-    pages& pages_, pages::index_type index_) :
-    obj_iface(pages_, index_)
-{
-    const auto size = obj_iface.size();
-    auto blk_count = size / sizeof(blob_blk);
+            // Data of the record in buffer.
+            const unsigned char* raw() const noexcept
+            {
+                return data;
+            }
 
-    if ((size % sizeof(blob_blk)) != 0 ||
-        blk_count > std::numeric_limits<blob::index_type>::max())
-    {
-        throw exception(
-            "Invalid BLOB-object size.");
-    }
-}
+            // Same as methods of 'records'.
+            template <typename Tvalue_type>
+            Tvalue_type get_field(field::index_type index_) const
+            {
+                return owner->template field_value<Tvalue_type>(data, index_);
+            }
 
+            std::optional<std::u16string_view> get_string(field::index_type index_) const
+            {
+                return owner->string_value(data, index_);
+            }
 
-template <typename Tobject_type>
-db_1cd_8x::pages::buffer_type
-db_1cd_8x::blob<Tobject_type>::get(
-    blob::index_type index_, std::size_t size_)
+            std::optional<blob_value> get_blob(field::index_type index_) const
+            {
+                return owner->blob_field(data, index_);
+            }
+
+            record_view(
+                const records& owner_, const unsigned char* data_,
+                arena::resource* memory_ = nullptr) :
+                owner(&owner_),
+                data(data_),
+                values_memory(memory_)
+            {
+            }
+        };
+
+        // Records readed by 'read_batch()'. Valid until next 'read_batch()'.
+        class batch_view
+        {
+        private:
+            const records* owner;
+            const unsigned char* data;                      // First record.
+            arena::resource* values_memory;                 // Memory of the batch.
+            records::index_type first_index;                // Index of the first record in table.
+            records::index_type count;                      // Records count.
+
+        public:
+            records::index_type first() const noexcept
+            {
+                return first_index;
+            }
+
+            records::index_type size() const noexcept
+            {
+                return count;
+            }
+
+            record_view operator[](records::index_type i_) const noexcept
+            {
+                assert(i_ < count);                         // Index out of the batch.
+                return record_view(*owner, data + owner->record.size() * i_, values_memory);
+            }
+
+            // Look 'record_view::memory()'.
+            arena::resource& memory() const noexcept
+            {
+                return *values_memory;
+            }
+
+            // Bitmap of not deleted records of the batch (look 'rows.h').
+            void live(bitmap_type& bits_) const
+            {
+                bits_.resize((count + 63) / 64);
+                rows::live_bitmap(data, owner->record.size(), count, bits_.data());
+            }
+
+            batch_view(
+                const records& owner_, const unsigned char* data_,
+                arena::resource& memory_,
+                records::index_type first_, records::index_type count_) :
+                owner(&owner_),
+                data(data_),
+                values_memory(&memory_),
+                first_index(first_),
+                count(count_)
+            {
+            }
+        };
+
+        // Strings of a column: string 'i' is [offsets[i], offsets[i + 1]) of 'data'.
+        struct strings_type
+        {
+            std::vector<std::uint32_t> offsets;             // Count of records + 1.
+            std::u16string data;                            // All strings one by one.
+        };
+
+        // Values of 'binary' and 'digit' fields as is.
+        struct bytes_type
+        {
+            std::size_t stride = 0;                         // Size of one value.
+            pages::buffer_type data;                        // Values one by one.
+        };
+
+        // Values of one field for range of records.
+        struct column
+        {
+            using values_type = std::variant<
+                std::vector<std::uint8_t>,                  // 'boolean' (0 or 1).
+                std::vector<field::version::value_type>,
+                std::vector<field::datetime::value_type>,
+                std::vector<field::bin_blob::value_type>,   // 'str_blob' and 'bin_blob'.
+                strings_type,                               // 'str_fix' (without trailing spaces) and 'str_var'.
+                bytes_type>;                                // 'binary' and 'digit'.
+
+            field::index_type index = 0;                    // Index of the field in table.
+            field::ftype type = field::ftype::unknown;      // Type of the field.
+            bitmap_type nulls;                              // Bit is set - NULL (or record is deleted).
+            values_type values;                             // NULL values are empty.
+        };
+
+        // Result of 'read_columns()'. Reuse it between calls to avoid allocations.
+        struct projection
+        {
+            records::index_type first = 0;                  // Index of the first record in table.
+            records::index_type count = 0;                  // Records count.
+            bitmap_type live;                               // Bit is set - record is not deleted.
+            std::vector<column> columns;                    // In order of requested fields.
+        };
+
+        // Condition for 'scan()'. Checked on data of the record in buffer,
+        // objects of fields are not created. NULL value does not match any
+        // condition except 'is_null()'.
+        class condition
+        {
+        public:
+            enum class kind
+            {
+                live,                                       // Record is not deleted.
+                is_null,                                    // Field value is NULL.
+                equal_bool,                                 // 'boolean' field equal to value.
+                equal_bytes,                                // 'binary' or 'digit' field equal to data.
+                prefix,                                     // 'str_fix' or 'str_var' field starts with string.
+                range                                       // 'datetime' field in [from, to].
+            };
+
+            kind type = kind::live;
+            field::index_type index = 0;                    // Index of the field in table.
+            bool flag = false;                              // Value for 'equal_bool'.
+            pages::buffer_type bytes;                       // Value for 'equal_bytes' (same size as field).
+            std::u16string text;                            // Value for 'prefix'.
+            field::datetime::value_type from;               // Bounds for 'range'.
+            field::datetime::value_type to;
+            field::datetime::stored_type stored_from{};     // Same as stored in record.
+            field::datetime::stored_type stored_to{};
+
+        public:
+            static condition live()
+            {
+                return condition();
+            }
+
+            static condition is_null(field::index_type index_)
+            {
+                condition result;
+                result.type = kind::is_null;
+                result.index = index_;
+                return result;
+            }
+
+            static condition equal(field::index_type index_, bool value_)
+            {
+                condition result;
+                result.type = kind::equal_bool;
+                result.index = index_;
+                result.flag = value_;
+                return result;
+            }
+
+            static condition equal(field::index_type index_, pages::buffer_type value_)
+            {
+                condition result;
+                result.type = kind::equal_bytes;
+                result.index = index_;
+                result.bytes = std::move(value_);
+                return result;
+            }
+
+            static condition prefix(field::index_type index_, std::u16string_view value_)
+            {
+                condition result;
+                result.type = kind::prefix;
+                result.index = index_;
+                result.text = value_;
+                return result;
+            }
+
+            static condition range(
+                field::index_type index_,
+                const field::datetime::value_type& from_,
+                const field::datetime::value_type& to_)
+            {
+                condition result;
+                result.type = kind::range;
+                result.index = index_;
+                result.from = from_;
+                result.to = to_;
+                result.stored_from = field::datetime::put(from_);
+                result.stored_to = field::datetime::put(to_);
+                return result;
+            }
+        };
+
+    private:
+        // Throws if condition does not fit to the field.
+        void check_condition(const condition& where_) const;
+
+        bool match(const unsigned char* record_, const condition& where_) const;
+
+        // Conditions of 'scan()': deleted records are skipped by bitmap,
+        // the rest conditions are checked for each live record.
+        struct prepared_where
+        {
+            bool live = false;
+            std::vector<const condition*> rest;
+        };
+
+        prepared_where prepare_where(const std::vector<condition>& where_) const;
+
+        // Calls 'func_(i, record)' for records in buffer that match 'where_'.
+        // Thread-safe for different buffers.
+        template <typename Tfunc>
+        void scan_data(
+            const unsigned char* data_, records::index_type count_,
+            const prepared_where& where_, bitmap_type& live_,
+            Tfunc func_) const;
+
+        // Records count in partition of 'parallel_scan()' (about 1MB of data,
+        // page-aligned).
+        records::index_type partition_size() const;
+
+        // Reads table by waves of partitions and calls
+        // 'func_(partition, index, record_view)' from tasks of 'workers_'.
+        // Task reads and scans one partition ('object::read_parts()').
+        template <typename Tfunc>
+        void scan_partitions(
+            const std::vector<condition>& where_,
+            workers::pool& workers_,
+            Tfunc func_);
+
+        std::optional<blob_value> blob_field(
+            const unsigned char* record_, field::index_type index_) const;
+
+        // Calls 'func_(i, value)' for each record of the range, 'value' is
+        // data of the field without NULL-flag or 'nullptr' (NULL or deleted).
+        template <typename Tfunc>
+        static void for_values(
+            column& column_, const unsigned char* data_, std::size_t rec_size_,
+            const projection& range_, const field_slot& slot_, Tfunc func_);
+
+        // Fills column of 'Tvalue_type' values returned by 'get_(value)'.
+        template <typename Tvalue_type, typename Tfunc>
+        static void fill_fixed(
+            column& column_, const unsigned char* data_, std::size_t rec_size_,
+            const projection& range_, const field_slot& slot_, Tfunc get_);
+
+        // Selects type of the column values (keeps memory if type not changed).
+        template <typename Tvalues_type>
+        static Tvalues_type& values_of(column& column_)
+        {
+            if (!std::holds_alternative<Tvalues_type>(column_.values))
+                column_.values.template emplace<Tvalues_type>();
+
+            return std::get<Tvalues_type>(column_.values);
+        }
+
+    public:
+        records(
+            pages& pages_,
+            pages::index_type index_,
+            const std::vector<field::fparams>& params_);
+
+        // Same, bound to BLOB-object 'blob_index_' (look 'table::params::i_blob')
+        // for access to BLOB fields by 'get_blob()'.
+        records(
+            pages& pages_,
+            pages::index_type index_,
+            pages::index_type blob_index_,
+            const std::vector<field::fparams>& params_);
+
+        // BLOB-object of the table (for example, to enable its cache).
+        blob<Tobject_type>& blob_object() const;
+
+        records::index_type size() const noexcept
+        {
+            return records_count;
+        }
+
+        field::index_type field_index(const std::wstring& name_) const;
+        void seek(records::index_type index_);
+        bool is_deleted() const;
+
+        template <typename Tvalue_type>
+        Tvalue_type get_field(field::index_type index_) const;
+
+        // Value of 'str_fix' (without trailing spaces) or 'str_var' field without
+        // copying. Points to the record buffer, valid until next 'seek()'.
+        std::optional<std::u16string_view> get_string(field::index_type index_) const;
+
+        // Handle of 'str_blob' or 'bin_blob' field value. Empty - NULL.
+        std::optional<blob_value> get_blob(field::index_type index_) const;
+
+        // Reads records [first_, first_ + count_) by one request to the object
+        // (less, if table ends). Memory of the buffer is reused between calls.
+        batch_view read_batch(records::index_type first_, records::index_type count_);
+
+        // Reads values of 'fields_' for records [first_, first_ + count_) to
+        // arrays of columns. Records are readed by 'read_batch()'.
+        void read_columns(
+            records::index_type first_, records::index_type count_,
+            const std::vector<field::index_type>& fields_,
+            projection& result_);
+
+        // Calls 'func_(index, record_view)' for records that match all
+        // conditions 'where_'. Records are readed by 'read_batch()' by
+        // 'batch_' records.
+        template <typename Tfunc>
+        void scan(
+            const std::vector<condition>& where_,
+            Tfunc func_,
+            records::index_type batch_ = 1024);
+
+        // Same as 'scan()', table is splitted to partitions processed in
+        // parallel by 'workers_'. Task reads data of its partition by
+        // 'Tobject_type::read_parts()' (bypassing the pages cache) and scans it.
+        // 'func_' is called from worker threads and must be thread-safe
+        // (don't read BLOB from it). Records of one partition are passed in
+        // order, partitions - in any order.
+        template <typename Tfunc>
+        void parallel_scan(
+            const std::vector<condition>& where_,
+            Tfunc func_,
+            workers::pool& workers_);
+
+        // Ordered output of 'parallel_scan()': 'func_(index, record_view)'
+        // returns 'std::optional<Tresult_type>', values are returned in order
+        // of records.
+        template <typename Tresult_type, typename Tfunc>
+        std::vector<Tresult_type> parallel_collect(
+            const std::vector<condition>& where_,
+            Tfunc func_,
+            workers::pool& workers_);
+
+#ifdef __cpp_impl_coroutine
+    public:
+        // Record of 'generate()' with its index in table.
+        struct row
+        {
+            records::index_type index;
+            record_view view;
+        };
+
+        // Range of records produced by coroutine, for range-for loop only.
+        class generator
+        {
+        public:
+            struct promise_type
+            {
+                const row* current = nullptr;               // Last yielded record.
+                std::exception_ptr error;                   // Error of the coroutine.
+
+                generator get_return_object() noexcept
+                {
+                    return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+                }
+
+                std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_always final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_always yield_value(const row& row_) noexcept
+                {
+                    current = &row_;
+                    return {};
+                }
+
+                void return_void() const noexcept
+                {
+                }
+
+                void unhandled_exception() noexcept
+                {
+                    error = std::current_exception();
+                }
+            };
+
+            using handle_type = std::coroutine_handle<promise_type>;
+
+        private:
+            handle_type handle;
+
+            static void resume(handle_type handle_)
+            {
+                handle_.resume();
+
+                if (handle_.promise().error)
+                    std::rethrow_exception(std::exchange(handle_.promise().error, nullptr));
+            }
+
+        public:
+            class iterator
+            {
+            private:
+                handle_type handle;
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = row;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const row*;
+                using reference = const row&;
+
+                reference operator*() const noexcept
+                {
+                    return *handle.promise().current;
+                }
+
+                pointer operator->() const noexcept
+                {
+                    return handle.promise().current;
+                }
+
+                iterator& operator++()
+                {
+                    resume(handle);
+                    return *this;
+                }
+
+                void operator++(int)
+                {
+                    ++*this;
+                }
+
+                bool operator==(std::default_sentinel_t) const noexcept
+                {
+                    return handle.done();
+                }
+
+                explicit iterator(handle_type handle_) noexcept : handle(handle_) {}
+            };
+
+            // Starts the coroutine, call once.
+            iterator begin()
+            {
+                resume(handle);
+                return iterator(handle);
+            }
+
+            std::default_sentinel_t end() const noexcept
+            {
+                return {};
+            }
+
+            explicit generator(handle_type handle_) noexcept : handle(handle_) {}
+
+            generator(const generator&) = delete;
+            generator& operator=(const generator&) = delete;
+
+            generator(generator&& src_) noexcept :
+                handle(std::exchange(src_.handle, nullptr))
+            {
+            }
+
+            generator& operator=(generator&& src_) noexcept
+            {
+                if (this != &src_)
+                {
+                    if (handle)
+                        handle.destroy();
+
+                    handle = std::exchange(src_.handle, nullptr);
+                }
+
+                return *this;
+            }
+
+            ~generator()
+            {
+                if (handle)
+                    handle.destroy();
+            }
+        };
+
+        // Live records that match 'where_' ('condition::live()' is implied),
+        // batch by batch. Reading of the next batch is started before
+        // records of the current one are yielded; at the start of the next
+        // batch the loop blocks until its reading ends. Views are valid
+        // until next step of the loop, 'record_view::memory()' - until next
+        // batch. Uses own buffers, so other methods can be called inside
+        // the loop.
+        //
+        //     for (const auto& item : recs.generate({}))
+        //         process(item.index, item.view);
+        generator generate(std::vector<condition> where_, records::index_type batch_ = 1024);
+#endif
+
+    public:
+        // Set of fields decoded by one pass through the record. Value of the
+        // step 'i' is written to 'values_[i]', values of deleted record are
+        // 'field::value()'. Strings point to the record buffer or, if
+        // 'memory_' is passed, are copied to it (look 'record_view::memory()').
+        class decode_plan
+        {
+        private:
+            std::vector<field_slot> steps;                  // Places of the fields in order of result.
+
+        public:
+            std::size_t size() const noexcept
+            {
+                return steps.size();
+            }
+
+            void decode(const unsigned char* record_, std::vector<field::value>& values_) const;
+
+            void decode(const record_view& record_, std::vector<field::value>& values_) const
+            {
+                decode(record_.raw(), values_);
+            }
+
+            void decode(
+                const unsigned char* record_, std::vector<field::value>& values_,
+                std::pmr::memory_resource& memory_) const
+            {
+                decode(record_, values_);
+
+                for (auto& item : values_)
+                    item.detach(memory_);
+            }
+
+            void decode(
+                const record_view& record_, std::vector<field::value>& values_,
+                std::pmr::memory_resource& memory_) const
+            {
+                decode(record_.raw(), values_, memory_);
+            }
+
+            decode_plan(std::vector<field_slot> steps_) :
+                steps(std::move(steps_))
+            {
+            }
+        };
+
+        // Values of 'digit' column as integers without decimal point
+        // ('value / 10^precision', look 'bcd.h'). NULL values are 0.
+        void column_to_int64(const column& column_, std::vector<std::int64_t>& values_) const;
+
+        // Values of 'datetime' field of records [first_, first_ + count_) as
+        // seconds from 1970-01-01 (look 'dates.h'), converted directly from
+        // the records buffer. NULL, deleted and invalid values are
+        // 'dates::invalid'. Returns count of the readed records.
+        records::index_type read_seconds(
+            records::index_type first_, records::index_type count_,
+            field::index_type index_, dates::format format_,
+            std::vector<std::int64_t>& values_);
+
+        // Plan for all fields of the table.
+        decode_plan make_plan() const
+        {
+            return decode_plan(slots);
+        }
+
+        // Plan for 'fields_' (projection).
+        decode_plan make_plan(const std::vector<field::index_type>& fields_) const;
+
+        // Decodes current record (after 'seek()').
+        void decode(const decode_plan& plan_, std::vector<field::value>& values_) const
+        {
+            plan_.decode(current(), values_);
+        }
+
+    private:
+        // Finds field by name and checks its type.
+        field_slot find_slot(const std::wstring& name_, field::ftype type_) const;
+
+    public:
+        // Known set of table fields. Each field is described by tag:
+        //
+        //     struct user_name
+        //     {
+        //         static constexpr std::wstring_view name = L"NAME";
+        //         using type = db_1cd_83::field::str_var;
+        //     };
+        //
+        // Fields are found and checked (type) once in constructor, values are
+        // readed by fixed offsets without searching and checking.
+        template <typename... Ttags>
+        class schema
+        {
+        private:
+            const records* owner;                           // Table records.
+            std::array<field_slot, sizeof...(Ttags)> slots; // In order of tags.
+
+            template <typename Ttag>
+            static constexpr std::size_t slot_index() noexcept
+            {
+                constexpr bool found[] = { std::is_same_v<Ttag, Ttags>... };
+                std::size_t i = 0;
+
+                while (i < sizeof...(Ttags) && !found[i])
+                    ++i;
+
+                return i;
+            }
+
+            // Value of the field in record buffer: same as 'records::get_string()'
+            // for strings, data as is for 'binary' and 'digit', 'get()' of the
+            // field for the rest.
+            template <typename Tfield_type>
+            static auto decode(const unsigned char* buff_, std::size_t size_)
+            {
+                constexpr field::ftype type = Tfield_type::type();
+
+                if constexpr (type == field::ftype::str_fix || type == field::ftype::str_var)
+                    return Tfield_type::view(buff_, size_);
+                else if constexpr (type == field::ftype::binary || type == field::ftype::digit)
+                    return typename blob<Tobject_type>::view_type{ buff_, size_ };
+                else
+                    return Tfield_type::get(buff_);
+            }
+
+        public:
+            template <typename Ttag>
+            using value_type = decltype(decode<typename Ttag::type>(nullptr, 0));
+
+            // Empty - NULL. Record must not be deleted.
+            template <typename Ttag>
+            std::optional<value_type<Ttag>> get(const unsigned char* record_) const
+            {
+                constexpr std::size_t index = slot_index<Ttag>();
+                static_assert(index < sizeof...(Ttags), "Field tag is not in schema.");
+
+                const field_slot& item = slots[index];
+
+                if (item.null_exists && record_[item.null_flag] == 0)
+                    return {};
+
+                return decode<typename Ttag::type>(record_ + item.data, item.size);
+            }
+
+            template <typename Ttag>
+            std::optional<value_type<Ttag>> get(const record_view& record_) const
+            {
+                return get<Ttag>(record_.raw());
+            }
+
+            // Current record of 'records' after 'seek()'.
+            template <typename Ttag>
+            std::optional<value_type<Ttag>> get() const
+            {
+                return get<Ttag>(owner->current());
+            }
+
+            schema(const records& records_) :
+                owner(&records_),
+                slots{ records_.find_slot(std::wstring(Ttags::name), Ttags::type::type())... }
+            {
+            }
+        };
+    };
+
+
+public:
+
+    class table
+    {
+    public:
+        struct params
+        {
+            std::wstring name;                              // Table name.
+            std::vector<field::fparams> columns;            // Fields parameters.
+            bool record_lock = false;                       // Special flag (unknown purpose).
+            pages::index_type i_records = 0;                // Index of the object with table records.
+            pages::index_type i_blob = 0;                   // ... with long data.
+            pages::index_type i_indexes = 0;                // ... with indexes (not implemented).
+        };
+    };
+
+
+protected:
+
+    class root
+    {
+    public:
+        static std::wstring parse_name(const std::wstring& descr_);
+        static std::vector<field::fparams> parse_fields(const std::wstring& descr_);
+        static bool parse_lock(const std::wstring& descr_);
+        static std::array<pages::index_type, 3> parse_files(const std::wstring& descr_);
+        static table::params parse_params(const std::wstring& descr_);
+    };
+
+};
+
+
+template <typename Tobject_type>
+db_1cd_8x::blob<Tobject_type>::blob(
+    pages& pages_, pages::index_type index_) :
+    obj_iface(pages_, index_)
+{
+    const auto size = obj_iface.size();
+    auto blk_count = size / sizeof(blob_blk);
+
+    if ((size % sizeof(blob_blk)) != 0 ||
+        blk_count > std::numeric_limits<blob::index_type>::max())
+    {
+        throw exception(
+            "Invalid BLOB-object size.");
+    }
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::blob<Tobject_type>::chain::chain(Tobject_type& obj_) :
+    obj_iface(obj_)
+{
+    blk_count = static_cast<blob::index_type>(
+        obj_iface.size() / sizeof(blob_blk));
+    loop_prot = blk_count;
+}
+
+
+template <typename Tobject_type>
+const typename db_1cd_8x::blob<Tobject_type>::blob_blk&
+db_1cd_8x::blob<Tobject_type>::chain::block(blob::index_type index_)
+{
+    if (index_ >= blk_count)
+    {
+        throw exception(
+            "Index of next BLOB block exceeds object size.");
+    }
+
+    const std::size_t page_size = obj_iface.page_size();
+    const auto blk_in_page = static_cast<blob::index_type>(page_size / sizeof(blob_blk));
+
+    const auto blk_pos =
+        static_cast<typename Tobject_type::size_type>(page_size) * (index_ / blk_in_page) +
+        static_cast<std::size_t>(index_ % blk_in_page) * sizeof(blob_blk);
+
+    if (window_data != nullptr &&
+        blk_pos >= window_pos &&
+        blk_pos - window_pos + sizeof(blob_blk) <= window_size)
+    {
+        auto* result = reinterpret_cast<const blob_blk*>(
+            window_data + static_cast<std::size_t>(blk_pos - window_pos));
+
+        if (result->length > sizeof(result->data) ||
+            (result->length == 0 && result->nextblock != 0))
+        {
+            throw exception(
+                "Wrong 'length' value in BLOB block.");
+        }
+
+        return *result;
+    }
+
+    if (page == nullptr ||
+        page_num != index_ / blk_in_page)
+    {
+        page_num = index_ / blk_in_page;
+
+        const auto page_pos =
+            static_cast<typename Tobject_type::size_type>(page_size) * page_num;
+        const auto view_size = static_cast<std::size_t>(
+            std::min<typename Tobject_type::size_type>(page_size, obj_iface.size() - page_pos));
+
+        page = reinterpret_cast<const unsigned char*>(
+            obj_iface.view(view_size, page_pos));
+    }
+
+    auto* result = reinterpret_cast<const blob_blk*>(
+        page + static_cast<std::size_t>(index_ % blk_in_page) * sizeof(blob_blk));
+
+    if (result->length > sizeof(result->data) ||
+        (result->length == 0 && result->nextblock != 0))
+    {
+        throw exception(
+            "Wrong 'length' value in BLOB block.");
+    }
+
+    return *result;
+}
+
+
+template <typename Tobject_type>
+typename db_1cd_8x::blob<Tobject_type>::index_type
+db_1cd_8x::blob<Tobject_type>::chain::next(const blob_blk& block_)
+{
+    if (block_.nextblock != 0 &&
+        --loop_prot == 0)
+    {
+        throw exception(
+            "Loop detected while BLOB reading.");
+    }
+
+    return block_.nextblock;
+}
+
+
+template <typename Tobject_type>
+template <typename Tfunc>
+void db_1cd_8x::blob<Tobject_type>::walk(
+    blob::index_type index_, Tfunc&& func_)
+{
+    chain blocks(obj_iface);
+    walk(blocks, index_, std::forward<Tfunc>(func_));
+}
+
+
+template <typename Tobject_type>
+template <typename Tfunc>
+void db_1cd_8x::blob<Tobject_type>::walk(
+    chain& blocks_, blob::index_type index_, Tfunc&& func_)
+{
+    if (index_ == 0)
+    {
+        throw exception(
+            "Invalid BLOB index parameter.");
+    }
+
+    do
+    {
+        const blob_blk& block = blocks_.block(index_);
+        func_(block.data, static_cast<std::size_t>(block.length));
+        index_ = blocks_.next(block);
+    } while (index_ != 0);
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::blob<Tobject_type>::reader::reader(
+    blob& blob_, blob::index_type index_, std::size_t size_) :
+    blocks(blob_.obj_iface),
+    index(index_),
+    expected(size_)
+{
+    if (index_ == 0)
+    {
+        throw exception(
+            "Invalid BLOB index parameter.");
+    }
+}
+
+
+template <typename Tobject_type>
+std::size_t db_1cd_8x::blob<Tobject_type>::reader::read(
+    void* dst_buff_, std::size_t count_)
+{
+    auto* dst_buff__ = reinterpret_cast<unsigned char*>(dst_buff_);
+    std::size_t readed = 0;
+
+    blocks.reset();                                         // Pages could be accessed after last call.
+
+    while (readed != count_ && index != 0)
+    {
+        const blob_blk& block = blocks.block(index);
+        const std::size_t to_read = std::min(
+            block.length - pos_in_block,
+            count_ - readed);
+
+        std::memcpy(
+            dst_buff__ + readed,
+            block.data + pos_in_block,
+            to_read);
+
+        readed += to_read;
+        pos_in_block += to_read;
+
+        if (pos_in_block == block.length)
+        {
+            index = blocks.next(block);
+            pos_in_block = 0;
+        }
+    }
+
+    total += readed;
+
+    if (expected != 0 &&
+        (total > expected || (index == 0 && total != expected)))
+    {
+        throw exception(
+            "Size of BLOB not equal requested value.");
+    }
+
+    return readed;
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::pages::buffer_type
+db_1cd_8x::blob<Tobject_type>::collect(
+    chain& blocks_, blob::index_type index_, std::size_t size_)
+{
+    pages::buffer_type result;
+
+    if (size_ != 0)
+        result.reserve(size_);
+
+    walk(blocks_, index_, [&](const unsigned char* data_, std::size_t length_)
+    {
+        if (size_ != 0 &&
+            (result.capacity() - result.size()) < length_)
+        {
+            throw exception(
+                "Not enough destination buffer size for BLOB.");
+        }
+
+        result.insert(result.end(), data_, data_ + length_);
+    });
+
+    if (size_ != 0 &&
+        size_ != result.size())
+    {
+        throw exception(
+            "Size of BLOB not equal requested value.");
+    }
+
+    return result;
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::pages::buffer_type
+db_1cd_8x::blob<Tobject_type>::get(
+    blob::index_type index_, std::size_t size_)
+{
+    chain blocks(obj_iface);
+    return collect(blocks, index_, size_);
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::blob_base::bounded_value
+db_1cd_8x::blob<Tobject_type>::get_bounded(
+    blob::index_type index_, std::size_t size_,
+    bool compressed_, std::size_t threshold_)
+{
+    constexpr std::size_t part_size = 64 * 1024;            // Buffer to read the value by parts.
+
+    bounded_value result(threshold_);
+    pages::buffer_type part(part_size);
+
+    if (compressed_)
+    {
+        inflate(index_, part.data(), part.size(), [&](const void* data_, std::size_t count_)
+        {
+            result.append(data_, count_);
+        },
+        size_);
+    }
+    else
+    {
+        reader src(*this, index_, size_);
+
+        while (!src.eof())
+            result.append(part.data(), src.read(part.data(), part.size()));
+    }
+
+    result.finish();
+    return result;
+}
+
+
+template <typename Tobject_type>
+typename db_1cd_8x::blob<Tobject_type>::view_type
+db_1cd_8x::blob<Tobject_type>::view(
+    blob::index_type index_, std::size_t size_)
+{
+    if (index_ == 0)
+    {
+        throw exception(
+            "Invalid BLOB index parameter.");
+    }
+
+    chain blocks(obj_iface);
+    const blob_blk& first = blocks.block(index_);
+
+    if (first.nextblock == 0)                               // One block - data in page.
+    {
+        if (size_ != 0 &&
+            size_ != first.length)
+        {
+            throw exception(
+                "Size of BLOB not equal requested value.");
+        }
+
+        return { first.data, first.length };
+    }
+
+    // Memory of the buffer is reused.
+    view_buff.clear();
+
+    walk(blocks, index_, [&](const unsigned char* data_, std::size_t length_)
+    {
+        if (size_ != 0 &&
+            (size_ - view_buff.size()) < length_)
+        {
+            throw exception(
+                "Not enough destination buffer size for BLOB.");
+        }
+
+        view_buff.insert(view_buff.end(), data_, data_ + length_);
+    });
+
+    if (size_ != 0 &&
+        size_ != view_buff.size())
+    {
+        throw exception(
+            "Size of BLOB not equal requested value.");
+    }
+
+    return { view_buff.data(), view_buff.size() };
+}
+
+
+template <typename Tobject_type>
+std::vector<db_1cd_8x::pages::buffer_type>
+db_1cd_8x::blob<Tobject_type>::get_many(const std::vector<blob::index_type>& indexes_)
+{
+    // Positions of the values sorted by first blocks (same as by pages of the object).
+    std::vector<std::size_t> order(indexes_.size());
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t left_, std::size_t right_)
+    {
+        return indexes_[left_] < indexes_[right_];
+    });
+
+    std::vector<pages::buffer_type> result(indexes_.size());
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        if (i != 0 &&
+            indexes_[order[i]] == indexes_[order[i - 1]])  // Same value - copy.
+        {
+            result[order[i]] = result[order[i - 1]];
+            continue;
+        }
+
+        chain blocks(obj_iface);
+        result[order[i]] = collect(blocks, indexes_[order[i]], 0);
+    }
+
+    return result;
+}
+
+
+template <typename Tobject_type>
+std::vector<db_1cd_8x::pages::buffer_type>
+db_1cd_8x::blob<Tobject_type>::get_many(
+    const std::vector<blob::index_type>& indexes_,
+    workers::pool& workers_)
+{
+    using size_type = typename Tobject_type::size_type;
+
+    constexpr std::size_t max_gap = 8;                      // Pages between values in one window.
+    constexpr std::size_t max_window = 16 * 1024 * 1024;    // Size of the window (bytes).
+    constexpr std::size_t max_round = 64 * 1024 * 1024;     // Windows readed at once (bytes).
+
+    // Pages of the object with near values (first blocks in 'order_[i_first, i_end)').
+    struct window_type
+    {
+        std::size_t i_first = 0;
+        std::size_t i_end = 0;
+        size_type pos = 0;
+        pages::buffer_type data;
+    };
+
+    // Order of the object pages stands in for physical order: placement of
+    // the object pages is known only by 'Tobject_type', which merges
+    // physically consecutive pages of the windows into one request.
+    std::vector<std::size_t> order(indexes_.size());
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t left_, std::size_t right_)
+    {
+        return indexes_[left_] < indexes_[right_];
+    });
+
+    const std::size_t page_size = obj_iface.page_size();
+    const auto blk_in_page = static_cast<blob::index_type>(page_size / sizeof(blob_blk));
+    const size_type obj_size = obj_iface.size();
+
+    std::vector<pages::buffer_type> result(indexes_.size());
+    std::vector<window_type> windows;
+    std::size_t i_first = 0;
+
+    while (i_first != order.size())
+    {
+        // Windows of the round are built first and readed by one job of
+        // 'workers_', so even small windows of scattered values are readed
+        // in parallel.
+        std::size_t round_size = 0;
+        windows.clear();
+
+        while (i_first != order.size() && round_size < max_round)
+        {
+            // Window: pages from the first block of the value to the first block of the
+            // last near value (and the next page for its tail).
+            const size_type first_page = indexes_[order[i_first]] / blk_in_page;
+            size_type last_page = first_page;
+            std::size_t i_end = i_first + 1;
+
+            while (i_end != order.size())
+            {
+                const size_type page_num = indexes_[order[i_end]] / blk_in_page;
+
+                if (page_num - last_page > max_gap ||
+                    (page_num - first_page + 2) * page_size > max_window)
+                {
+                    break;
+                }
+
+                last_page = page_num;
+                ++i_end;
+            }
+
+            window_type& window = windows.emplace_back();
+            window.i_first = i_first;
+            window.i_end = i_end;
+            window.pos = first_page * page_size;
+
+            if (window.pos < obj_size)
+            {
+                window.data.resize(static_cast<std::size_t>(std::min<size_type>(
+                    (last_page - first_page + 2) * page_size,
+                    obj_size - window.pos)));
+            }
+
+            round_size += window.data.size();
+            i_first = i_end;
+        }
+
+        std::vector<typename Tobject_type::interval> intervals;
+        intervals.reserve(windows.size());
+
+        for (auto& window : windows)
+        {
+            if (!window.data.empty())
+                intervals.push_back({ window.data.data(), window.data.size(), window.pos });
+        }
+
+        obj_iface.read(intervals, workers_);
+
+        // Chains are walked by this thread: blocks outside of the window are
+        // readed through the pages cache.
+        for (const auto& window : windows)
+        {
+            for (std::size_t i = window.i_first; i < window.i_end; ++i)
+            {
+                if (i != 0 &&
+                    indexes_[order[i]] == indexes_[order[i - 1]])
+                {
+                    result[order[i]] = result[order[i - 1]];
+                    continue;
+                }
+
+                chain blocks(obj_iface);
+                blocks.window(window.data.data(), window.pos, window.data.size());
+
+                result[order[i]] = collect(blocks, indexes_[order[i]], 0);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+template <typename Tobject_type>
+template <typename Tresult, typename Tfunc>
+std::shared_ptr<const Tresult>
+db_1cd_8x::blob<Tobject_type>::get_decoded(
+    blob::index_type index_, std::size_t size_, decoded_kind kind_,
+    Tfunc&& decode_)
+{
+    const std::uint64_t key =
+        (static_cast<std::uint64_t>(index_) << 2) |
+        static_cast<std::uint64_t>(kind_);
+
+    bool cached = false;
+
+    if (decoded)
+    {
+        const std::optional<decoded_type> found = decoded->find(key);
+
+        if (found.has_value())
+        {
+            if (size_ == 0 || size_ == found->stored_size)
+                return std::get<std::shared_ptr<const Tresult>>(found->value);
+
+            cached = true;                                  // Other size: checked by reading.
+        }
+    }
+
+    pages::buffer_type stored = get(index_, size_);
+    const std::size_t stored_size = stored.size();
+
+    auto result = std::make_shared<const Tresult>(decode_(std::move(stored)));
+
+    if (decoded && !cached)
+    {
+        const std::size_t weight =
+            result->size() * sizeof(typename Tresult::value_type) + decoded_overhead;
+
+        decoded->push(std::make_pair(key, decoded_type{ stored_size, result }), weight);
+    }
+
+    return result;
+}
+
+
+template <typename Tobject_type>
+void db_1cd_8x::blob<Tobject_type>::cache_limit(std::size_t bytes_)
+{
+    if (bytes_ == 0)
+        decoded.reset();
+    else
+        decoded = std::make_unique<cache::weighted_lru<std::uint64_t, decoded_type>>(bytes_);
+}
+
+
+template <typename Tobject_type>
+std::shared_ptr<const db_1cd_8x::pages::buffer_type>
+db_1cd_8x::blob<Tobject_type>::get_data(
+    blob::index_type index_, std::size_t size_,
+    bool compressed_, std::size_t expected_size_)
+{
+    if (!compressed_)
+    {
+        return get_decoded<pages::buffer_type>(index_, size_, decoded_kind::data,
+            [](pages::buffer_type&& stored_)
+            {
+                return std::move(stored_);
+            });
+    }
+
+    return get_decoded<pages::buffer_type>(index_, size_, decoded_kind::inflated_data,
+        [expected_size_](pages::buffer_type&& stored_)
+        {
+            return decompress(stored_, std::numeric_limits<uInt>::max(), expected_size_);
+        });
+}
+
+
+template <typename Tobject_type>
+std::shared_ptr<const std::wstring>
+db_1cd_8x::blob<Tobject_type>::get_text(
+    blob::index_type index_, std::size_t size_,
+    bool compressed_, std::size_t expected_size_)
+{
+    if (!compressed_)
+    {
+        return get_decoded<std::wstring>(index_, size_, decoded_kind::text,
+            [](pages::buffer_type&& stored_)
+            {
+                return utf8to16(stored_);
+            });
+    }
+
+    return get_decoded<std::wstring>(index_, size_, decoded_kind::inflated_text,
+        [expected_size_](pages::buffer_type&& stored_)
+        {
+            return utf8to16(decompress(stored_, std::numeric_limits<uInt>::max(), expected_size_));
+        });
+}
+
+
+template <typename Tobject_type>
+template <typename Tfunc>
+void db_1cd_8x::blob<Tobject_type>::inflate(
+    blob::index_type index_,
+    void* dst_buff_, std::size_t dst_size_,
+    Tfunc&& func_,
+    std::size_t size_)
+{
+    if (index_ == 0)
+    {
+        throw exception(
+            "Invalid BLOB index parameter.");
+    }
+
+    if (dst_size_ == 0)
+    {
+        throw exception(
+            "Empty destination buffer for decompressed BLOB.");
+    }
+
+    chain blocks(obj_iface);
+    inflater::pooled strm;
+
+    auto* dst_buff__ = reinterpret_cast<unsigned char*>(dst_buff_);
+    std::size_t dst_pos = 0;
+    std::size_t pos_in_block = 0;
+    std::size_t stored = 0;                                 // Size of the passed blocks.
+
+    for (;;)
+    {
+        const blob_blk& block = blocks.block(index_);
+        std::size_t produced = 0;
+
+        const std::size_t consumed = strm->inflate(
+            block.data + pos_in_block, block.length - pos_in_block,
+            dst_buff__ + dst_pos, dst_size_ - dst_pos,
+            produced);
+
+        pos_in_block += consumed;
+        dst_pos += produced;
+
+        if (dst_pos == dst_size_)
+        {
+            func_(dst_buff_, dst_pos);
+            dst_pos = 0;
+            blocks.reset();                                 // 'func_' could access pages.
+            continue;
+        }
+
+        if (strm->finished())
+            break;
+
+        if (pos_in_block == block.length)
+        {
+            stored += block.length;
+            index_ = blocks.next(block);
+            pos_in_block = 0;
+
+            if (size_ != 0 && stored > size_)
+            {
+                throw exception(
+                    "Size of BLOB not equal requested value.");
+            }
+
+            if (index_ == 0)
+            {
+                throw exception(
+                    "Data flow ended before it was decompressed by ZLIB.");
+            }
+        }
+        else if (consumed == 0 && produced == 0)
+        {
+            throw exception(
+                "ZLIB doesn't process data of BLOB.");
+        }
+    }
+
+    if (size_ != 0)
+    {
+        // Blocks after the end of ZLIB stream are counted too.
+        do
+        {
+            const blob_blk& block = blocks.block(index_);
+            stored += block.length;
+            index_ = blocks.next(block);
+        } while (index_ != 0 && stored <= size_);
+
+        if (stored != size_)
+        {
+            throw exception(
+                "Size of BLOB not equal requested value.");
+        }
+    }
+
+    if (dst_pos != 0)
+        func_(dst_buff_, dst_pos);
+}
+
+
+template <typename Tobject_type>
+std::size_t db_1cd_8x::records<Tobject_type>::prepare_fields(
+    const std::vector<field::fparams>& params_)
+{
+    if (params_.size() > std::numeric_limits<field::index_type>::max())
+    {
+        throw exception(
+            "Table fields count exceeds maximum allowed value.");
+    }
+
+    indexes.clear();
+    slots.clear();
+    slots.reserve(params_.size());
+    params = params_;
+
+    field::index_type index = 0;
+    std::size_t shift = 1;                                  // First byte - record deletion flag.
+    for (const auto& prm : params_)
+    {
+        std::size_t size =
+            prm.null_exists ? 1 : 0;
+
+        switch (prm.type)
+        {
+        case field::ftype::binary:              size += field::binary::size(prm.length); break;
+        case field::ftype::boolean:             size += field::boolean::size(prm.length); break;
+        case field::ftype::digit:               size += field::digit::size(prm.length); break;
+        case field::ftype::str_fix:             size += field::str_fix::size(prm.length); break;
+        case field::ftype::str_var:             size += field::str_var::size(prm.length); break;
+        case field::ftype::version:             size += field::version::size(prm.length); break;
+        case field::ftype::str_blob:            size += field::str_blob::size(prm.length); break;
+        case field::ftype::bin_blob:            size += field::bin_blob::size(prm.length); break;
+        case field::ftype::datetime:            size += field::datetime::size(prm.length); break;
+        default:
+            throw exception(
+                "Unknown table field type in table record.");
+        }
+
+        field_slot& slot = slots.emplace_back();
+
+        slot.type = prm.type;
+        slot.null_exists = prm.null_exists;
+        slot.null_flag = static_cast<std::uint32_t>(shift);
+        slot.data = static_cast<std::uint32_t>(shift + (prm.null_exists ? 1 : 0));
+        slot.size = static_cast<std::uint32_t>(size - (prm.null_exists ? 1 : 0));
+
+        indexes[prm.name] = index++;
+
+        shift += size;
+    }
+
+    // Table records can't be shortest of the element of the free records chain.
+    constexpr std::size_t min_rec_size =
+        1 + sizeof(records::index_type);
+    if (shift < min_rec_size)
+        shift = min_rec_size;
+
+    return shift;
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::records<Tobject_type>::records(
+    pages& pages_,
+    pages::index_type index_,
+    const std::vector<field::fparams>& params_) :
+    obj_iface(pages_, index_)
+{
+    const auto rec_size = prepare_fields(params_);
+    const auto obj_size = obj_iface.size();
+    const auto rec_cnt = obj_size / rec_size;
+
+    if ((obj_size % rec_size) != 0 ||
+        rec_cnt > std::numeric_limits<records::index_type>::max())
+    {
+        throw exception(
+            "Invalid table records object size.");
+    }
+
+    record.resize(rec_size);
+    records_count = static_cast<records::index_type>(rec_cnt);
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::records<Tobject_type>::records(
+    pages& pages_,
+    pages::index_type index_,
+    pages::index_type blob_index_,
+    const std::vector<field::fparams>& params_) :
+    records(pages_, index_, params_)
+{
+    blob_iface = std::make_unique<blob<Tobject_type>>(pages_, blob_index_);
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::blob<Tobject_type>& db_1cd_8x::records<Tobject_type>::blob_object() const
+{
+    if (!blob_iface)
+    {
+        throw exception(
+            "Table records are not bound to BLOB-object.");
+    }
+
+    return *blob_iface;
+}
+
+
+template <typename Tobject_type>
+db_1cd_8x::field::index_type db_1cd_8x::records<Tobject_type>::field_index(
+    const std::wstring& name_) const
+{
+    try
+    {
+        return indexes.at(name_);
+    }
+    catch (std::out_of_range&)
+    {
+        throw exception(
+            "Table field by name not found.");
+    }
+}
+
+
+template <typename Tobject_type>
+void db_1cd_8x::records<Tobject_type>::seek(records::index_type index_)
+{
+    if (index_ >= size())
+    {
+        throw exception(
+            "Requested table record number exceeds object size.");
+    }
+
+    if (last_index.has_value() &&
+        *last_index == index_)
+    {
+        return;
+    }
+
+    last_index.reset();                                     // try ...
+    obj_iface.read(
+        record.data(),
+        record.size(),
+        static_cast<Tobject_type::size_type>(record.size()) * index_);
+    last_index = index_;                                    // ... catch
+}
+
+
+template <typename Tobject_type>
+bool db_1cd_8x::records<Tobject_type>::is_deleted() const
+{
+    if (!seek_success())                                    /// assert() ?
+    {
+        throw exception(
+            "Attempting to access a table entry before reading it.");
+    }
+
+    std::uint8_t deleted = 0;
+    mem_get(record.data(), deleted);
+
+    return deleted == 1 ? true : false;
+}
+
+
+template <typename Tobject_type>
+const unsigned char* db_1cd_8x::records<Tobject_type>::current() const
+{
+    if (!seek_success())                                    /// assert() ?
+    {
+        throw exception(
+            "Attempting to access a table entry before reading it.");
+    }
+
+    assert(!is_deleted());                                  // Record does not have data (deleted).
+
+    return record.data();
+}
+
+
+template <typename Tobject_type>
+const void* db_1cd_8x::records<Tobject_type>::field_data(
+    const unsigned char* record_,
+    field::index_type index_, field::ftype type_,
+    std::size_t& size_) const
+{
+    const auto& slot = slots.at(index_);
+
+    if (slot.type != type_)
+    {
+        throw exception(
+            "Attempting reads table field with wrong type.");
+    }
+
+    if (slot.null_exists && record_[slot.null_flag] == 0)
+        return nullptr;
+
+    size_ = slot.size;
+    return record_ + slot.data;
+}
+
+
+template <typename Tobject_type>
+template <typename Tvalue_type>
+Tvalue_type db_1cd_8x::records<Tobject_type>::field_value(
+    const unsigned char* record_, field::index_type index_) const
+{
+    std::size_t size = 0;
+    const void* buff = field_data(record_, index_, Tvalue_type::type(), size);
+
+    if (buff == nullptr)
+        return Tvalue_type(params[index_]);
+
+    return Tvalue_type(params[index_], buff, size);
+}
+
+
+template <typename Tobject_type>
+template <typename Tvalue_type>
+Tvalue_type db_1cd_8x::records<Tobject_type>::get_field(field::index_type index_) const
+{
+    return field_value<Tvalue_type>(current(), index_);
+}
+
+
+template <typename Tobject_type>
+std::optional<std::u16string_view>
+db_1cd_8x::records<Tobject_type>::string_value(
+    const unsigned char* record_, field::index_type index_) const
+{
+    const field::ftype type = slots.at(index_).type;
+
+    if (type != field::ftype::str_fix &&
+        type != field::ftype::str_var)
+    {
+        throw exception(
+            "Attempting reads table field with wrong type.");
+    }
+
+    std::size_t size = 0;
+    const void* buff = field_data(record_, index_, type, size);
+
+    if (buff == nullptr)
+        return {};
+
+    return type == field::ftype::str_fix ?
+        field::str_fix::view(buff, size) :
+        field::str_var::view(buff, size);
+}
+
+
+template <typename Tobject_type>
+std::optional<std::u16string_view>
+db_1cd_8x::records<Tobject_type>::get_string(field::index_type index_) const
+{
+    return string_value(current(), index_);
+}
+
+
+template <typename Tobject_type>
+std::optional<typename db_1cd_8x::records<Tobject_type>::blob_value>
+db_1cd_8x::records<Tobject_type>::blob_field(
+    const unsigned char* record_, field::index_type index_) const
+{
+    blob<Tobject_type>& blob_ref = blob_object();
+    std::optional<field::bin_blob::value_type> value;
+
+    switch (slots.at(index_).type)
+    {
+    case field::ftype::bin_blob:
+        value = field_value<field::bin_blob>(record_, index_).exists;
+        break;
+
+    case field::ftype::str_blob:
+    {
+        const auto str = field_value<field::str_blob>(record_, index_);
+
+        if (str.exists.has_value())
+            value = field::bin_blob::value_type{ str.exists->index, str.exists->size };
+
+        break;
+    }
+
+    default:
+        throw exception(
+            "Attempting reads table field with wrong type.");
+    }
+
+    if (!value.has_value())
+        return {};
+
+    return blob_value(blob_ref, value->index, value->size);
+}
+
+
+template <typename Tobject_type>
+std::optional<typename db_1cd_8x::records<Tobject_type>::blob_value>
+db_1cd_8x::records<Tobject_type>::get_blob(field::index_type index_) const
+{
+    return blob_field(current(), index_);
+}
+
+
+template <typename Tobject_type>
+const unsigned char* db_1cd_8x::records<Tobject_type>::read_raw(
+    records::index_type first_, records::index_type& count_)
+{
+    if (first_ >= size())
+    {
+        throw exception(
+            "Requested table record number exceeds object size.");
+    }
+
+    constexpr std::size_t align = 64;                       // Cache line.
+
+    count_ = std::min(count_, size() - first_);
+
+    const std::size_t rec_size = record.size();
+    const std::size_t data_size = rec_size * count_;
+
+    if (batch_buff.size() < data_size + align)
+        batch_buff.resize(data_size + align);
+
+    auto* data = batch_buff.data() +
+        (align - reinterpret_cast<std::uintptr_t>(batch_buff.data()) % align) % align;
+
+    obj_iface.read(
+        data,
+        data_size,
+        static_cast<typename Tobject_type::size_type>(rec_size) * first_);
+
+    return data;
+}
+
+
+template <typename Tobject_type>
+typename db_1cd_8x::records<Tobject_type>::batch_view
+db_1cd_8x::records<Tobject_type>::read_batch(
+    records::index_type first_, records::index_type count_)
+{
+    const unsigned char* data = read_raw(first_, count_);
+    batch_arena.reset();
+
+    return batch_view(*this, data, batch_arena, first_, count_);
+}
+
+
+template <typename Tobject_type>
+template <typename Tfunc>
+void db_1cd_8x::records<Tobject_type>::for_values(
+    column& column_, const unsigned char* data_, std::size_t rec_size_,
+    const projection& range_, const field_slot& slot_, Tfunc func_)
 {
-    if (index_ == 0)
+    for (records::index_type i = 0; i < range_.count; ++i, data_ += rec_size_)
     {
-        throw exception(
-            "Invalid BLOB index parameter.");
+        if (!test(range_.live, i) ||
+            (slot_.null_exists && data_[slot_.null_flag] == 0))
+        {
+            column_.nulls[i / 64] |= std::uint64_t(1) << (i % 64);
+            func_(i, nullptr);
+        }
+        else
+            func_(i, data_ + slot_.data);
     }
+}
 
-    thread_local blob_blk buffer;
-    pages::buffer_type result;
 
-    if (size_ != 0)
-        result.reserve(size_);
+template <typename Tobject_type>
+template <typename Tvalue_type, typename Tfunc>
+void db_1cd_8x::records<Tobject_type>::fill_fixed(
+    column& column_, const unsigned char* data_, std::size_t rec_size_,
+    const projection& range_, const field_slot& slot_, Tfunc get_)
+{
+    auto& values = values_of<std::vector<Tvalue_type>>(column_);
+    values.assign(range_.count, Tvalue_type());
 
-    const auto blk_count = static_cast<blob::index_type>(
-        obj_iface.size() / sizeof(blob_blk));
-    blob::index_type loop_prot = blk_count;
+    for_values(column_, data_, rec_size_, range_, slot_,
+        [&values, get_](records::index_type i_, const unsigned char* buff_)
+        {
+            if (buff_ != nullptr)
+                values[i_] = get_(buff_);
+        });
+}
 
-    do
+
+template <typename Tobject_type>
+void db_1cd_8x::records<Tobject_type>::read_columns(
+    records::index_type first_, records::index_type count_,
+    const std::vector<field::index_type>& fields_,
+    projection& result_)
+{
+    for (const auto index : fields_)
+        slots.at(index);                                    // Check indexes before reading.
+
+    const unsigned char* data = read_raw(first_, count_);
+    const std::size_t rec_size = record.size();
+    const std::size_t words = (count_ + 63) / 64;
+
+    result_.first = first_;
+    result_.count = count_;
+    result_.live.resize(words);
+    rows::live_bitmap(data, rec_size, count_, result_.live.data());
+
+    result_.columns.resize(fields_.size());
+
+    for (std::size_t c = 0; c < fields_.size(); ++c)
     {
-        if (index_ >= blk_count)
+        const auto& slot = slots[fields_[c]];
+        const std::size_t size = slot.size;
+        column& col = result_.columns[c];
+
+        col.index = fields_[c];
+        col.type = slot.type;
+        col.nulls.assign(words, 0);
+
+        switch (slot.type)
         {
-            throw exception(
-                "Index of next BLOB block exceeds object size.");
-        }
+        case field::ftype::boolean:
+            fill_fixed<std::uint8_t>(col, data, rec_size, result_, slot, field::boolean::get);
+            break;
+
+        case field::ftype::version:
+            fill_fixed<field::version::value_type>(col, data, rec_size, result_, slot, field::version::get);
+            break;
+
+        case field::ftype::datetime:
+            fill_fixed<field::datetime::value_type>(col, data, rec_size, result_, slot, field::datetime::get);
+            break;
 
-        obj_iface.read(
-            &buffer, sizeof(buffer),
-            static_cast<Tobject_type::size_type>(sizeof(blob_blk)) * index_);
+        case field::ftype::str_blob:
+        case field::ftype::bin_blob:
+            fill_fixed<field::bin_blob::value_type>(col, data, rec_size, result_, slot, field::bin_blob::get);
+            break;
 
-        if (buffer.length > sizeof(buffer.data) ||
-            (buffer.length == 0 && buffer.nextblock != 0))
+        case field::ftype::str_fix:
+        case field::ftype::str_var:
         {
-            throw exception(
-                "Wrong 'length' value in BLOB block.");
+            const bool is_fix = slot.type == field::ftype::str_fix;
+
+            auto& strings = values_of<strings_type>(col);
+            strings.offsets.resize(count_ + 1);
+            strings.data.clear();
+
+            for_values(col, data, rec_size, result_, slot,
+                [&strings, is_fix, size](records::index_type i_, const unsigned char* buff_)
+                {
+                    strings.offsets[i_] = static_cast<std::uint32_t>(strings.data.size());
+
+                    if (buff_ != nullptr)
+                    {
+                        strings.data += is_fix ?
+                            field::str_fix::view(buff_, size) :
+                            field::str_var::view(buff_, size);
+                    }
+                });
+
+            strings.offsets[count_] = static_cast<std::uint32_t>(strings.data.size());
+            break;
         }
 
-        if (size_ != 0 &&
-            (result.capacity() - result.size()) < buffer.length)
+        case field::ftype::binary:
+        case field::ftype::digit:
         {
+            auto& bytes = values_of<bytes_type>(col);
+            bytes.stride = size;
+            bytes.data.assign(size * count_, 0);
+
+            for_values(col, data, rec_size, result_, slot,
+                [&bytes, size](records::index_type i_, const unsigned char* buff_)
+                {
+                    if (buff_ != nullptr)
+                        std::memcpy(bytes.data.data() + size * i_, buff_, size);
+                });
+            break;
+        }
+
+        default:
             throw exception(
-                "Not enough destination buffer size for BLOB.");
+                "Unsupported table field type in column reading.");
         }
+    }
+}
 
-        auto ibegin = std::begin(buffer.data);
-        result.insert(result.end(), ibegin, ibegin + buffer.length);
 
-        if (buffer.nextblock == 0)
-        {
-            if (size_ != 0 &&
-                size_ != result.size())
-            {
-                throw exception(
-                    "Size of BLOB not equal requested value.");
-            }
+template <typename Tobject_type>
+void db_1cd_8x::records<Tobject_type>::check_condition(const condition& where_) const
+{
+    if (where_.type == condition::kind::live)
+        return;
 
-            return result;
-        }
+    const auto& slot = slots.at(where_.index);
+    bool valid = false;
 
-        index_ = buffer.nextblock;
-    } while (--loop_prot);
+    switch (where_.type)
+    {
+    case condition::kind::is_null:
+        valid = slot.null_exists;
+        break;
+
+    case condition::kind::equal_bool:
+        valid = slot.type == field::ftype::boolean;
+        break;
+
+    case condition::kind::equal_bytes:
+        valid =
+            (slot.type == field::ftype::binary ||
+             slot.type == field::ftype::digit) &&
+            where_.bytes.size() == slot.size;
+        break;
+
+    case condition::kind::prefix:
+        valid =
+            (slot.type == field::ftype::str_fix ||
+             slot.type == field::ftype::str_var) &&
+            where_.text.size() <= params[where_.index].length;
+        break;
+
+    case condition::kind::range:
+        valid = slot.type == field::ftype::datetime;
+        break;
+
+    default:
+        break;
+    }
 
-    throw exception(
-        "Loop detected while BLOB reading.");
+    if (!valid)
+    {
+        throw exception(
+            "Condition of records scan does not fit to table field.");
+    }
 }
 
 
 template <typename Tobject_type>
-std::size_t db_1cd_8x::records<Tobject_type>::prepare_fields(
-    const std::vector<field::fparams>& params_)
+bool db_1cd_8x::records<Tobject_type>::match(
+    const unsigned char* record_, const condition& where_) const
 {
-    if (params_.size() > std::numeric_limits<field::index_type>::max())
+    if (where_.type == condition::kind::live)
+        return record_[0] != 1;
+
+    const auto& slot = slots[where_.index];
+
+    if (slot.null_exists && record_[slot.null_flag] == 0)
+        return where_.type == condition::kind::is_null;
+
+    const unsigned char* buff = record_ + slot.data;
+
+    switch (where_.type)
     {
-        throw exception(
-            "Table fields count exceeds maximum allowed value.");
-    }
+    case condition::kind::equal_bool:
+        return (*buff != 0) == where_.flag;
 
-    indexes.clear();
-    fields.clear();
-    fields.reserve(params_.size());
+    case condition::kind::equal_bytes:
+        return std::memcmp(buff, where_.bytes.data(), slot.size) == 0;
 
-    field::index_type index = 0;
-    std::size_t shift = 1;                                  // First byte - record deletion flag.
-    for (const auto& prm : params_)
+    case condition::kind::prefix:
     {
-        std::size_t size =
-            prm.null_exists ? 1 : 0;
+        const std::size_t bytes = where_.text.size() * sizeof(char16_t);
 
-        switch (prm.type)
+        if (slot.type == field::ftype::str_var)
         {
-        case field::ftype::binary:              size += field::binary::size(prm.length); break;
-        case field::ftype::boolean:             size += field::boolean::size(prm.length); break;
-        case field::ftype::digit:               size += field::digit::size(prm.length); break;
-        case field::ftype::str_fix:             size += field::str_fix::size(prm.length); break;
-        case field::ftype::str_var:             size += field::str_var::size(prm.length); break;
-        case field::ftype::version:             size += field::version::size(prm.length); break;
-        case field::ftype::str_blob:            size += field::str_blob::size(prm.length); break;
-        case field::ftype::bin_blob:            size += field::bin_blob::size(prm.length); break;
-        case field::ftype::datetime:            size += field::datetime::size(prm.length); break;
-        default:
-            throw exception(
-                "Unknown table field type in table record.");
+            std::uint16_t real_len = 0;
+            buff = static_cast<const unsigned char*>(mem_get(buff, real_len));
+
+            if (real_len < where_.text.size())
+                return false;
         }
 
-        helper& hlp = fields.emplace_back();
+        return std::memcmp(buff, where_.text.data(), bytes) == 0;
+    }
 
-        hlp.params = prm;
-        hlp.shift = shift;
-        hlp.size = size;
+    case condition::kind::range:                            // Packed decimal: order of bytes is order of values.
+        return
+            std::memcmp(where_.stored_from.data(), buff, where_.stored_from.size()) <= 0 &&
+            std::memcmp(buff, where_.stored_to.data(), where_.stored_to.size()) <= 0;
 
-        indexes[prm.name] = index++;
+    default:                                                // 'is_null' for not NULL value.
+        return false;
+    }
+}
 
-        shift += size;
+
+template <typename Tobject_type>
+typename db_1cd_8x::records<Tobject_type>::prepared_where
+db_1cd_8x::records<Tobject_type>::prepare_where(const std::vector<condition>& where_) const
+{
+    prepared_where result;
+
+    for (const auto& where : where_)
+    {
+        check_condition(where);
+
+        if (where.type == condition::kind::live)
+            result.live = true;
+        else
+            result.rest.push_back(&where);
     }
 
-    // Table records can't be shortest of the element of the free records chain.
-    constexpr std::size_t min_rec_size =
-        1 + sizeof(records::index_type);
-    if (shift < min_rec_size)
-        shift = min_rec_size;
+    return result;
+}
 
-    return shift;
+
+template <typename Tobject_type>
+template <typename Tfunc>
+void db_1cd_8x::records<Tobject_type>::scan_data(
+    const unsigned char* data_, records::index_type count_,
+    const prepared_where& where_, bitmap_type& live_,
+    Tfunc func_) const
+{
+    const std::size_t rec_size = record.size();
+    live_.resize((count_ + 63) / 64);
+
+    if (where_.live)
+        rows::live_bitmap(data_, rec_size, count_, live_.data());
+    else
+        std::fill(live_.begin(), live_.end(), ~std::uint64_t(0));
+
+    rows::for_each_bit(live_.data(), count_,
+        [&](std::size_t i_)
+        {
+            const unsigned char* rec = data_ + rec_size * i_;
+
+            const bool matched = std::all_of(
+                where_.rest.begin(), where_.rest.end(),
+                [this, rec](const condition* item_)
+                {
+                    return match(rec, *item_);
+                });
+
+            if (matched)
+                func_(static_cast<records::index_type>(i_), rec);
+        });
 }
 
 
 template <typename Tobject_type>
-db_1cd_8x::records<Tobject_type>::records(
-    pages& pages_,
-    pages::index_type index_,
-    const std::vector<field::fparams>& params_) :
-    obj_iface(pages_, index_)
+template <typename Tfunc>
+void db_1cd_8x::records<Tobject_type>::scan(
+    const std::vector<condition>& where_,
+    Tfunc func_,
+    records::index_type batch_)
 {
-    const auto rec_size = prepare_fields(params_);
-    const auto obj_size = obj_iface.size();
-    const auto rec_cnt = obj_size / rec_size;
+    const prepared_where where = prepare_where(where_);
+    bitmap_type live;
 
-    if ((obj_size % rec_size) != 0 ||
-        rec_cnt > std::numeric_limits<records::index_type>::max())
+    batch_ = std::max<records::index_type>(batch_, 1);
+
+    for (records::index_type first = 0; first < size(); first += batch_)
     {
-        throw exception(
-            "Invalid table records object size.");
+        records::index_type count = batch_;
+        const unsigned char* data = read_raw(first, count);
+        batch_arena.reset();
+
+        scan_data(data, count, where, live,
+            [&](records::index_type i_, const unsigned char* record_)
+            {
+                func_(first + i_, record_view(*this, record_, &batch_arena));
+            });
     }
+}
 
-    record.resize(rec_size);
-    records_count = static_cast<records::index_type>(rec_cnt);
+
+template <typename Tobject_type>
+typename db_1cd_8x::records<Tobject_type>::index_type
+db_1cd_8x::records<Tobject_type>::partition_size() const
+{
+    constexpr std::size_t partition_bytes = 1024 * 1024;
+    constexpr std::size_t max_aligned_bytes = 16 * 1024 * 1024;
+
+    const std::size_t page_size = obj_iface.page_size();
+    const std::size_t rec_size = record.size();
+
+    // Page boundary falls between records each 'unit' records: partitions
+    // of such records count start and end on page boundaries, so no page
+    // is readed by two tasks. Too large unit (odd size of record) - partitions
+    // aren't aligned.
+    const std::size_t unit = page_size / std::gcd(page_size, rec_size);
+
+    if (unit * rec_size > max_aligned_bytes)
+    {
+        return static_cast<records::index_type>(
+            std::max(partition_bytes / rec_size, std::size_t(1)));
+    }
+
+    return static_cast<records::index_type>(
+        std::max(partition_bytes / rec_size / unit, std::size_t(1)) * unit);
 }
 
 
 template <typename Tobject_type>
-db_1cd_8x::field::index_type db_1cd_8x::records<Tobject_type>::field_index(
-    const std::wstring& name_) const
+template <typename Tfunc>
+void db_1cd_8x::records<Tobject_type>::scan_partitions(
+    const std::vector<condition>& where_,
+    workers::pool& workers_,
+    Tfunc func_)
 {
-    try
+    const prepared_where where = prepare_where(where_);
+    const std::size_t rec_size = record.size();
+    const records::index_type part_size = partition_size();
+    const std::size_t wave_parts = (workers_.size() + 1) * 2;   // Partitions readed at once.
+
+    pages::buffer_type buff;
+    std::vector<bitmap_type> live(wave_parts);
+
+    for (records::index_type first = 0; first < size();)
     {
-        return indexes.at(name_);
+        const auto count = static_cast<records::index_type>(std::min<std::uint64_t>(
+            static_cast<std::uint64_t>(part_size) * wave_parts,
+            size() - first));
+
+        // Placement of the pages resolved by this thread, each task reads
+        // its partition and scans it while other tasks are reading.
+        buff.resize(rec_size * count);
+        obj_iface.read_parts(
+            buff.data(),
+            buff.size(),
+            static_cast<typename Tobject_type::size_type>(rec_size) * first,
+            rec_size * part_size,
+            workers_,
+            [&](std::size_t part_)
+            {
+                const auto part_first = static_cast<records::index_type>(part_ * part_size);
+                const records::index_type part_count = std::min(part_size, count - part_first);
+                const std::size_t partition = first / part_size + part_;
+
+                scan_data(buff.data() + rec_size * part_first, part_count, where, live[part_],
+                    [&](records::index_type i_, const unsigned char* record_)
+                    {
+                        func_(partition, first + part_first + i_, record_view(*this, record_));
+                    });
+            });
+
+        first += count;
     }
-    catch (std::out_of_range&)
+}
+
+
+template <typename Tobject_type>
+template <typename Tfunc>
+void db_1cd_8x::records<Tobject_type>::parallel_scan(
+    const std::vector<condition>& where_,
+    Tfunc func_,
+    workers::pool& workers_)
+{
+    scan_partitions(where_, workers_,
+        [&func_](std::size_t, records::index_type index_, const record_view& record_)
+        {
+            func_(index_, record_);
+        });
+}
+
+
+template <typename Tobject_type>
+template <typename Tresult_type, typename Tfunc>
+std::vector<Tresult_type> db_1cd_8x::records<Tobject_type>::parallel_collect(
+    const std::vector<condition>& where_,
+    Tfunc func_,
+    workers::pool& workers_)
+{
+    const records::index_type part_size = partition_size();
+    std::vector<std::vector<Tresult_type>> parts((size() + part_size - 1) / part_size);
+
+    scan_partitions(where_, workers_,
+        [&func_, &parts](std::size_t partition_, records::index_type index_, const record_view& record_)
+        {
+            std::optional<Tresult_type> value = func_(index_, record_);
+
+            if (value.has_value())
+                parts[partition_].push_back(std::move(*value));
+        });
+
+    std::size_t total = 0;
+
+    for (const auto& part : parts)
+        total += part.size();
+
+    std::vector<Tresult_type> result;
+    result.reserve(total);
+
+    for (auto& part : parts)
+        std::move(part.begin(), part.end(), std::back_inserter(result));
+
+    return result;
+}
+
+
+#ifdef __cpp_impl_coroutine
+template <typename Tobject_type>
+typename db_1cd_8x::records<Tobject_type>::generator
+db_1cd_8x::records<Tobject_type>::generate(
+    std::vector<condition> where_,
+    records::index_type batch_)
+{
+    const prepared_where where = prepare_where(where_);
+    const std::size_t rec_size = record.size();
+
+    batch_ = std::max<records::index_type>(batch_, 1);
+
+    // Buffers are declared before 'prefetch': its destructor waits for the
+    // current reading before the buffers are freed. One thread reads all
+    // batches of the generator.
+    pages::buffer_type buffs[2];
+    bitmap_type live;
+    arena::resource memory;
+    workers::background prefetch;
+    std::future<void> pending;
+
+    auto start = [&](records::index_type first_, std::size_t buff_)
     {
-        throw exception(
-            "Table field by name not found.");
+        const records::index_type count = std::min<records::index_type>(batch_, size() - first_);
+
+        buffs[buff_].resize(rec_size * count);
+        pending = obj_iface.read_async(
+            buffs[buff_].data(),
+            buffs[buff_].size(),
+            static_cast<typename Tobject_type::size_type>(rec_size) * first_,
+            prefetch);
+    };
+
+    if (size() == 0)
+        co_return;
+
+    start(0, 0);
+
+    for (records::index_type first = 0, buff = 0; first < size(); first += batch_, buff ^= 1)
+    {
+        const records::index_type count = std::min<records::index_type>(batch_, size() - first);
+
+        pending.get();                                      // Blocks the consumer until the batch is readed.
+
+        if (size() - first > batch_)                        // Prefetch of the next batch.
+            start(first + batch_, buff ^ 1);
+
+        const unsigned char* data = buffs[buff].data();
+
+        live.resize((count + 63) / 64);
+        rows::live_bitmap(data, rec_size, count, live.data());
+        memory.reset();
+
+        for (std::size_t w = 0; w < live.size(); ++w)
+        {
+            for (std::uint64_t word = live[w]; word != 0; word &= word - 1)
+            {
+                const std::size_t i = w * 64 + rows::lowest_bit(word);
+
+                if (i >= count)
+                    break;
+
+                const unsigned char* rec = data + rec_size * i;
+
+                const bool matched = std::all_of(
+                    where.rest.begin(), where.rest.end(),
+                    [this, rec](const condition* item_)
+                    {
+                        return match(rec, *item_);
+                    });
+
+                if (matched)
+                    co_yield row{ first + static_cast<records::index_type>(i), record_view(*this, rec, &memory) };
+            }
+        }
     }
 }
+#endif
 
 
 template <typename Tobject_type>
-void db_1cd_8x::records<Tobject_type>::seek(records::index_type index_)
+void db_1cd_8x::records<Tobject_type>::column_to_int64(
+    const column& column_, std::vector<std::int64_t>& values_) const
 {
-    if (index_ >= size())
+    const std::size_t length = params.at(column_.index).length;
+
+    if (column_.type != field::ftype::digit ||
+        length > bcd::max_int64_digits)
     {
         throw exception(
-            "Requested table record number exceeds object size.");
+            "Column can't be converted to 64-bit integers.");
     }
 
-    if (last_index.has_value() &&
-        *last_index == index_)
+    const auto& bytes = std::get<bytes_type>(column_.values);
+    const std::size_t count = bytes.stride == 0 ? 0 : bytes.data.size() / bytes.stride;
+
+    values_.resize(count);
+    bcd::to_int64(bytes.data.data(), bytes.stride, count, length, values_.data());
+
+    for (std::size_t i = 0; i < count; ++i)                 // Zero bytes of NULL are negative zero.
     {
-        return;
+        if (test(column_.nulls, i))
+            values_[i] = 0;
     }
-
-    last_index.reset();                                     // try ...
-    obj_iface.read(
-        record.data(),
-        record.size(),
-        static_cast<Tobject_type::size_type>(record.size()) * index_);
-    last_index = index_;                                    // ... catch
 }
 
 
 template <typename Tobject_type>
-bool db_1cd_8x::records<Tobject_type>::is_deleted() const
+typename db_1cd_8x::records<Tobject_type>::index_type
+db_1cd_8x::records<Tobject_type>::read_seconds(
+    records::index_type first_, records::index_type count_,
+    field::index_type index_, dates::format format_,
+    std::vector<std::int64_t>& values_)
 {
-    if (!seek_success())                                    /// assert() ?
+    const auto& slot = slots.at(index_);
+
+    if (slot.type != field::ftype::datetime)
     {
         throw exception(
-            "Attempting to access a table entry before reading it.");
+            "Field type isn't 'datetime'.");
     }
 
-    std::uint8_t deleted = 0;
-    mem_get(record.data(), deleted);
+    const unsigned char* data = read_raw(first_, count_);
+    const std::size_t rec_size = record.size();
 
-    return deleted == 1 ? true : false;
+    std::vector<std::uint64_t> live((count_ + 63) / 64);
+    rows::live_bitmap(data, rec_size, count_, live.data());
+
+    values_.resize(count_);
+    dates::to_seconds(data + slot.data, rec_size, count_, format_, values_.data());
+
+    for (records::index_type i = 0; i < count_; ++i, data += rec_size)
+    {
+        if (!test(live, i) ||
+            (slot.null_exists && data[slot.null_flag] == 0))
+        {
+            values_[i] = dates::invalid;
+        }
+    }
+
+    return count_;
 }
 
 
 template <typename Tobject_type>
-template <typename Tvalue_type>
-Tvalue_type db_1cd_8x::records<Tobject_type>::get_field(field::index_type index_) const
+typename db_1cd_8x::records<Tobject_type>::decode_plan
+db_1cd_8x::records<Tobject_type>::make_plan(const std::vector<field::index_type>& fields_) const
 {
-    if (!seek_success())                                    /// assert() ?
+    std::vector<field_slot> steps;
+    steps.reserve(fields_.size());
+
+    for (const auto index : fields_)
+        steps.push_back(slots.at(index));
+
+    return decode_plan(std::move(steps));
+}
+
+
+template <typename Tobject_type>
+void db_1cd_8x::records<Tobject_type>::decode_plan::decode(
+    const unsigned char* record_, std::vector<field::value>& values_) const
+{
+    values_.resize(steps.size());
+
+    if (record_[0] == 1)                                    // Deleted record.
     {
-        throw exception(
-            "Attempting to access a table entry before reading it.");
+        std::fill(values_.begin(), values_.end(), field::value());
+        return;
     }
 
-    assert(!is_deleted());                                  // Record does not have data (deleted).
+    for (std::size_t i = 0; i < steps.size(); ++i)
+    {
+        const field_slot& step = steps[i];
+
+        if (step.null_exists && record_[step.null_flag] == 0)
+            values_[i] = field::value(step.type);
+        else
+            values_[i] = field::value(step.type, record_ + step.data, step.size);
+    }
+}
 
-    const auto& helper = fields.at(index_);
 
-    if (helper.params.type != Tvalue_type::type())
+template <typename Tobject_type>
+typename db_1cd_8x::records<Tobject_type>::field_slot
+db_1cd_8x::records<Tobject_type>::find_slot(const std::wstring& name_, field::ftype type_) const
+{
+    const auto& slot = slots[field_index(name_)];
+
+    if (slot.type != type_)
     {
         throw exception(
-            "Attempting reads table field with wrong type.");
+            "Table field type differs from schema.");
     }
 
-    const void* buff = &record[helper.shift];
-    auto size = helper.size;
+    return slot;
+}
 
-    if (helper.params.null_exists)
-    {
-        std::uint8_t has_value = 0;
-        buff = mem_get(buff, has_value);
 
-        if (has_value == 0)
-            return Tvalue_type(helper.params);
+template <typename Tobject_type>
+typename db_1cd_8x::blob<Tobject_type>::view_type
+db_1cd_8x::records<Tobject_type>::blob_value::view() const
+{
+    if (length == 0)
+        return {};
+
+    return blob_iface->view(index, length);
+}
+
 
-        size -= sizeof(has_value);
-    }
+template <typename Tobject_type>
+std::shared_ptr<const db_1cd_8x::pages::buffer_type>
+db_1cd_8x::records<Tobject_type>::blob_value::data(
+    bool compressed_, std::size_t expected_size_) const
+{
+    if (length == 0)                                        // Empty value doesn't have blocks.
+        return std::make_shared<const pages::buffer_type>();
+
+    return blob_iface->get_data(index, length, compressed_, expected_size_);
+}
+
+
+template <typename Tobject_type>
+std::shared_ptr<const std::wstring>
+db_1cd_8x::records<Tobject_type>::blob_value::text(
+    bool compressed_, std::size_t expected_size_) const
+{
+    if (length == 0)
+        return std::make_shared<const std::wstring>();
 
-    return Tvalue_type(helper.params, buff, size);
+    return blob_iface->get_text(index, length, compressed_, expected_size_);
 }
@@ -0,0 +1,572 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <algorithm>
+
+#include "rfc1951.h"
+
+
+namespace rfc1951
+{
+
+    namespace
+    {
+
+        constexpr unsigned max_code_len = 15;               // Longest Huffman code.
+        constexpr unsigned litlen_root = 10;                // Bits of the first level tables.
+        constexpr unsigned dist_root = 8;
+        constexpr unsigned codelen_root = 7;
+
+        // Table entry: bits 0..7 - code length (or bits of the subtable),
+        // bit 8 - link to the subtable, bits 16..31 - symbol (or subtable start).
+        // Zero entry - code not exists.
+        constexpr std::uint32_t entry_sub = 0x100;
+
+        using litlen_table = std::array<std::uint32_t, 2048>;
+        using dist_table = std::array<std::uint32_t, 1024>;
+        using codelen_table = std::array<std::uint32_t, 128>;
+
+        constexpr std::uint16_t len_base[29] = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        constexpr std::uint8_t len_extra[29] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        constexpr std::uint16_t dist_base[30] = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+        constexpr std::uint8_t dist_extra[30] = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        constexpr std::uint8_t codelen_order[19] = {
+            16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+
+        // Builds decoding table for canonical Huffman code by lengths of the codes.
+        bool build_table(
+            const std::uint8_t* lens_, unsigned count_,
+            std::uint32_t* table_, std::size_t table_size_,
+            unsigned root_, bool allow_incomplete_)
+        {
+            unsigned count[max_code_len + 1] = { 0 };       // Codes count of each length.
+            unsigned offs[max_code_len + 2] = { 0 };
+            std::uint16_t sorted[320];                      // Symbols sorted by code length.
+
+            for (unsigned sym = 0; sym < count_; ++sym)
+                ++count[lens_[sym]];
+
+            count[0] = 0;
+
+            unsigned max_len = max_code_len;
+            while (max_len != 0 && count[max_len] == 0)
+                --max_len;
+
+            std::fill(table_, table_ + (std::size_t(1) << root_), 0);
+
+            if (max_len == 0)                               // No codes - any use is error.
+                return allow_incomplete_;
+
+            int left = 1;
+            for (unsigned len = 1; len <= max_code_len; ++len)
+            {
+                left <<= 1;
+                left -= count[len];
+
+                if (left < 0)                               // Over-subscribed.
+                    return false;
+            }
+
+            if (left > 0 &&
+                (!allow_incomplete_ || max_len != 1))       // Incomplete allowed for single code only.
+            {
+                return false;
+            }
+
+            for (unsigned len = 1; len <= max_code_len; ++len)
+                offs[len + 1] = offs[len] + count[len];
+
+            for (unsigned sym = 0; sym < count_; ++sym)
+            {
+                if (lens_[sym] != 0)
+                    sorted[offs[lens_[sym]]++] = static_cast<std::uint16_t>(sym);
+            }
+
+            const std::size_t root_size = std::size_t(1) << root_;
+            std::size_t next_sub = root_size;               // Start of the next subtable.
+            std::size_t sub_start = 0;
+            unsigned sub_bits = 0;
+            std::size_t sub_prefix = root_size;             // Prefix of current subtable (none).
+
+            unsigned code = 0;                              // Canonical code (MSB first).
+            unsigned i_sorted = 0;
+
+            for (unsigned len = 1; len <= max_len; ++len, code <<= 1)
+            {
+                for (unsigned n = count[len]; n != 0; --n, ++code)
+                {
+                    const std::uint32_t sym = sorted[i_sorted++];
+
+                    unsigned rev = 0;                       // Deflate reads codes from LSB.
+                    for (unsigned bit = 0; bit < len; ++bit)
+                        rev |= ((code >> bit) & 1) << (len - 1 - bit);
+
+                    if (len <= root_)
+                    {
+                        for (std::size_t i = rev; i < root_size; i += std::size_t(1) << len)
+                            table_[i] = (sym << 16) | len;
+                    }
+                    else
+                    {
+                        const std::size_t prefix = rev & (root_size - 1);
+
+                        if (prefix != sub_prefix)
+                        {
+                            // Subtable size - enough for all codes with this prefix.
+                            sub_bits = len - root_;
+                            int sub_left = 1 << sub_bits;
+
+                            while (sub_bits + root_ < max_len)
+                            {
+                                sub_left -= count[sub_bits + root_];
+
+                                if (sub_left <= 0)
+                                    break;
+
+                                ++sub_bits;
+                                sub_left <<= 1;
+                            }
+
+                            if (next_sub + (std::size_t(1) << sub_bits) > table_size_)
+                                return false;
+
+                            sub_prefix = prefix;
+                            sub_start = next_sub;
+                            next_sub += std::size_t(1) << sub_bits;
+
+                            std::fill(
+                                table_ + sub_start,
+                                table_ + sub_start + (std::size_t(1) << sub_bits),
+                                0);
+
+                            table_[prefix] = static_cast<std::uint32_t>(
+                                (sub_start << 16) | entry_sub | sub_bits);
+                        }
+
+                        for (std::size_t i = rev >> root_; i < (std::size_t(1) << sub_bits);
+                            i += std::size_t(1) << (len - root_))
+                        {
+                            table_[sub_start + i] = (sym << 16) | (len - root_);
+                        }
+                    }
+
+                    --count[len];                           // Left codes count (for subtables size).
+                }
+            }
+
+            return true;
+        }
+
+
+        class decoder
+        {
+        private:
+            const std::uint8_t* const in_begin;
+            const std::uint8_t* const in_end;
+            const std::uint8_t* in;                         // Next byte to load into bits buffer.
+            std::size_t overrun = 0;                        // Zero bytes loaded after end of source.
+
+            std::uint64_t bits = 0;                         // Bits buffer (LSB - next bit).
+            unsigned bits_count = 0;                        // Valid bits in buffer.
+
+            std::uint8_t* const out_begin;
+            std::uint8_t* const out_end;
+            std::uint8_t* out;
+
+            litlen_table litlen;
+            dist_table dist;
+
+            void refill() noexcept
+            {
+                if (in_end - in >= 8)
+                {
+                    std::uint64_t word;
+                    std::memcpy(&word, in, sizeof(word));   // Little-endian only.
+
+                    bits |= word << bits_count;
+                    in += (63 - bits_count) >> 3;
+                    bits_count |= 56;
+                }
+                else
+                {
+                    while (bits_count <= 56)
+                    {
+                        if (in != in_end)
+                            bits |= std::uint64_t(*in++) << bits_count;
+                        else
+                            ++overrun;
+
+                        bits_count += 8;
+                    }
+                }
+            }
+
+            std::uint32_t get(unsigned count_) noexcept
+            {
+                if (bits_count < count_)
+                    refill();
+
+                const auto result = static_cast<std::uint32_t>(
+                    bits & ((std::uint64_t(1) << count_) - 1));
+
+                bits >>= count_;
+                bits_count -= count_;
+
+                return result;
+            }
+
+            bool src_ended() const noexcept
+            {
+                const std::size_t loaded = static_cast<std::size_t>(in - in_begin) + overrun;
+                return loaded * 8 - bits_count > static_cast<std::size_t>(in_end - in_begin) * 8;
+            }
+
+            // Bits buffer must have at least 15 bits. Returns -1 for invalid code.
+            int symbol(const std::uint32_t* table_, unsigned root_) noexcept
+            {
+                std::uint32_t entry = table_[bits & ((1u << root_) - 1)];
+
+                if (entry & entry_sub)
+                {
+                    bits >>= root_;
+                    bits_count -= root_;
+
+                    entry = table_[(entry >> 16) + (bits & ((1u << (entry & 0xFF)) - 1))];
+                }
+
+                const unsigned len = entry & 0xFF;
+
+                if (len == 0)
+                    return -1;
+
+                bits >>= len;
+                bits_count -= len;
+
+                return static_cast<int>(entry >> 16);
+            }
+
+            status stored_block();
+            status dynamic_tables();
+            status fixed_tables();
+            status huffman_block();
+
+        public:
+            status run(std::size_t& src_used_, std::size_t& dst_used_);
+
+            decoder(
+                const void* src_, std::size_t src_size_,
+                void* dst_buff_, std::size_t dst_size_) :
+                in_begin(reinterpret_cast<const std::uint8_t*>(src_)),
+                in_end(in_begin + src_size_),
+                in(in_begin),
+                out_begin(reinterpret_cast<std::uint8_t*>(dst_buff_)),
+                out_end(out_begin + dst_size_),
+                out(out_begin)
+            {
+            }
+        };
+
+
+        status decoder::stored_block()
+        {
+            get(bits_count & 7);                            // Skip bits to the byte boundary.
+
+            const std::uint32_t len = get(16);
+            const std::uint32_t nlen = get(16);
+
+            if (src_ended())
+                return status::src_end;
+
+            if ((len ^ 0xFFFF) != nlen)
+                return status::bad_data;
+
+            // Return unused whole bytes from bits buffer.
+            const std::uint8_t* pos = in - ((bits_count >> 3) - overrun);
+            bits = 0;
+            bits_count = 0;
+            overrun = 0;
+
+            if (static_cast<std::size_t>(in_end - pos) < len)
+                return status::src_end;
+
+            if (static_cast<std::size_t>(out_end - out) < len)
+                return status::dst_overflow;
+
+            if (len != 0)
+            {
+                std::memcpy(out, pos, len);
+                out += len;
+            }
+
+            in = pos + len;
+
+            return status::ok;
+        }
+
+
+        status decoder::fixed_tables()
+        {
+            std::uint8_t lens[288 + 32];
+
+            std::fill(lens, lens + 144, std::uint8_t(8));
+            std::fill(lens + 144, lens + 256, std::uint8_t(9));
+            std::fill(lens + 256, lens + 280, std::uint8_t(7));
+            std::fill(lens + 280, lens + 288, std::uint8_t(8));
+            std::fill(lens + 288, lens + 320, std::uint8_t(5));
+
+            if (!build_table(lens, 288, litlen.data(), litlen.size(), litlen_root, false) ||
+                !build_table(lens + 288, 32, dist.data(), dist.size(), dist_root, false))
+            {
+                return status::bad_data;
+            }
+
+            return status::ok;
+        }
+
+
+        status decoder::dynamic_tables()
+        {
+            const unsigned nlen = get(5) + 257;
+            const unsigned ndist = get(5) + 1;
+            const unsigned ncode = get(4) + 4;
+
+            if (nlen > 286 || ndist > 30)
+                return status::bad_data;
+
+            std::uint8_t lens[286 + 30] = { 0 };
+
+            for (unsigned i = 0; i < ncode; ++i)
+                lens[codelen_order[i]] = static_cast<std::uint8_t>(get(3));
+
+            codelen_table codelen;
+
+            if (!build_table(lens, 19, codelen.data(), codelen.size(), codelen_root, false))
+                return status::bad_data;
+
+            unsigned i_len = 0;
+
+            while (i_len < nlen + ndist)
+            {
+                if (bits_count < 16)
+                    refill();
+
+                if (src_ended())
+                    return status::src_end;
+
+                const int sym = symbol(codelen.data(), codelen_root);
+
+                if (sym < 0)
+                    return status::bad_data;
+
+                if (sym < 16)
+                {
+                    lens[i_len++] = static_cast<std::uint8_t>(sym);
+                    continue;
+                }
+
+                std::uint8_t value = 0;
+                unsigned repeat = 0;
+
+                if (sym == 16)
+                {
+                    if (i_len == 0)
+                        return status::bad_data;
+
+                    value = lens[i_len - 1];
+                    repeat = 3 + get(2);
+                }
+                else if (sym == 17)
+                    repeat = 3 + get(3);
+                else
+                    repeat = 11 + get(7);
+
+                if (i_len + repeat > nlen + ndist)
+                    return status::bad_data;
+
+                std::fill(lens + i_len, lens + i_len + repeat, value);
+                i_len += repeat;
+            }
+
+            if (lens[256] == 0)                             // End of block code is absent.
+                return status::bad_data;
+
+            if (!build_table(lens, nlen, litlen.data(), litlen.size(), litlen_root, true) ||
+                !build_table(lens + nlen, ndist, dist.data(), dist.size(), dist_root, true))
+            {
+                return status::bad_data;
+            }
+
+            return status::ok;
+        }
+
+
+        status decoder::huffman_block()
+        {
+            for (;;)
+            {
+                // 56 bits enough for length code with extra bits and distance code with extra bits.
+                if (bits_count < 48)
+                    refill();
+
+                const int sym = symbol(litlen.data(), litlen_root);
+
+                if (sym < 256)
+                {
+                    if (sym < 0)
+                        return status::bad_data;
+
+                    if (out == out_end)
+                        return src_ended() ? status::src_end : status::dst_overflow;
+
+                    *out++ = static_cast<std::uint8_t>(sym);
+
+                    // Next literal without refill of the bits buffer.
+                    if (bits_count >= max_code_len)
+                    {
+                        const std::uint32_t entry = litlen[bits & ((1u << litlen_root) - 1)];
+
+                        if ((entry & entry_sub) == 0 &&
+                            (entry >> 16) < 256 &&
+                            (entry & 0xFF) != 0 &&
+                            out != out_end)
+                        {
+                            bits >>= entry & 0xFF;
+                            bits_count -= entry & 0xFF;
+                            *out++ = static_cast<std::uint8_t>(entry >> 16);
+                        }
+                    }
+
+                    continue;
+                }
+
+                if (sym == 256)
+                    return src_ended() ? status::src_end : status::ok;
+
+                const unsigned i_len = static_cast<unsigned>(sym) - 257;
+
+                if (i_len >= 29)
+                    return status::bad_data;
+
+                const std::size_t len = len_base[i_len] + get(len_extra[i_len]);
+                const int i_dist = symbol(dist.data(), dist_root);
+
+                if (i_dist < 0 || i_dist >= 30)
+                    return status::bad_data;
+
+                const std::size_t distance = dist_base[i_dist] + get(dist_extra[i_dist]);
+
+                if (src_ended())
+                    return status::src_end;
+
+                if (distance > static_cast<std::size_t>(out - out_begin))
+                    return status::bad_data;
+
+                if (len > static_cast<std::size_t>(out_end - out))
+                    return status::dst_overflow;
+
+                const std::uint8_t* from = out - distance;
+                std::uint8_t* const end = out + len;
+
+                if (distance >= 8 &&
+                    static_cast<std::size_t>(out_end - end) >= 8)
+                {
+                    // Copy by words: source is far enough, destination has space for overrun.
+                    do
+                    {
+                        std::uint64_t word;
+                        std::memcpy(&word, from, sizeof(word));
+                        std::memcpy(out, &word, sizeof(word));
+
+                        out += sizeof(word);
+                        from += sizeof(word);
+                    } while (out < end);
+                }
+                else if (distance == 1)
+                {
+                    std::memset(out, *from, len);
+                }
+                else                                        // Overlapped copy - repeating pattern.
+                {
+                    while (out != end)
+                        *out++ = *from++;
+                }
+
+                out = end;
+            }
+        }
+
+
+        status decoder::run(std::size_t& src_used_, std::size_t& dst_used_)
+        {
+            status result = status::ok;
+            bool last = false;
+
+            while (!last && result == status::ok)
+            {
+                last = get(1) != 0;
+                const std::uint32_t type = get(2);
+
+                if (src_ended())
+                    return status::src_end;
+
+                switch (type)
+                {
+                case 0:     result = stored_block(); break;
+                case 1:     if ((result = fixed_tables()) == status::ok) result = huffman_block(); break;
+                case 2:     if ((result = dynamic_tables()) == status::ok) result = huffman_block(); break;
+                default:    result = status::bad_data; break;
+                }
+            }
+
+            if (result == status::ok)
+            {
+                const std::size_t loaded = static_cast<std::size_t>(in - in_begin) + overrun;
+                src_used_ = (loaded * 8 - bits_count + 7) / 8;
+                dst_used_ = static_cast<std::size_t>(out - out_begin);
+            }
+
+            return result;
+        }
+
+    }
+
+
+    status decode(
+        const void* src_, std::size_t src_size_,
+        void* dst_buff_, std::size_t dst_size_,
+        std::size_t& src_used_, std::size_t& dst_used_)
+    {
+        src_used_ = 0;
+        dst_used_ = 0;
+
+        decoder dec(src_, src_size_, dst_buff_, dst_size_);
+        return dec.run(src_used_, dst_used_);
+    }
+
+}
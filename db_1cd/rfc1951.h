@@ -0,0 +1,53 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Decoder of the raw 'deflate' data (https://tools.ietf.org/html/rfc1951).
+
+   Decodes whole buffer at once into buffer of known size. No streaming, no
+   internal state between calls, so it is faster than ZLIB for the data when
+   size of the result is known. Huffman codes decoded by two-level tables,
+   bits are read by 64-bit words.
+
+   Usage:
+   Call 'decode()' with source and destination buffers. If result is
+   'status::dst_overflow', destination buffer is too small - use streaming
+   decoder (ZLIB) or larger buffer.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace rfc1951
+{
+
+    enum class status
+    {
+        ok = 0,                                             // Data successfully decoded.
+        bad_data,                                           // Invalid format of the data.
+        src_end,                                            // Source data ended before end of the stream.
+        dst_overflow                                        // Not enough destination buffer size.
+    };
+
+    // 'src_used_' - size of the stream in source, 'dst_used_' - size of the result.
+    status decode(
+        const void* src_, std::size_t src_size_,
+        void* dst_buff_, std::size_t dst_size_,
+        std::size_t& src_used_, std::size_t& dst_used_);
+
+}
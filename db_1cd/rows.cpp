@@ -0,0 +1,121 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <cstring>
+
+#include "rows.h"
+#include "cpu.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define ROWS_AVX2
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#define ROWS_AVX2_FUNC
+#else
+#define ROWS_AVX2_FUNC __attribute__((target("avx2")))
+#endif
+#endif
+
+
+namespace rows
+{
+
+    namespace
+    {
+
+        constexpr std::uint8_t deleted = 1;                 // Value of deletion flag.
+
+
+        // Sets bits [first_, count_) of cleared bitmap.
+        void live_scalar(
+            const std::uint8_t* data_, std::size_t stride_,
+            std::size_t first_, std::size_t count_,
+            std::uint64_t* bits_) noexcept
+        {
+            for (std::size_t i = first_; i < count_; ++i)
+            {
+                const std::uint64_t live = data_[i * stride_] != deleted;
+                bits_[i / 64] |= live << (i % 64);
+            }
+        }
+
+
+#ifdef ROWS_AVX2
+
+        const bool use_avx2 = cpu::avx2_supported();
+
+
+        // Sets bits by blocks of 8 records: 4 bytes from the begin of each
+        // record are gathered, flags are compared. Returns count of the
+        // processed records. 'stride_' - 4 bytes at least.
+        ROWS_AVX2_FUNC
+        std::size_t live_avx2(
+            const std::uint8_t* data_, std::size_t stride_, std::size_t count_,
+            std::uint64_t* bits_) noexcept
+        {
+            const int stride = static_cast<int>(stride_);
+            const __m256i offsets = _mm256_setr_epi32(
+                0, stride, stride * 2, stride * 3,
+                stride * 4, stride * 5, stride * 6, stride * 7);
+            const __m256i low_byte = _mm256_set1_epi32(0xFF);
+            const __m256i flag = _mm256_set1_epi32(deleted);
+
+            std::size_t done = 0;
+
+            for (; count_ - done >= 8; done += 8)
+            {
+                const __m256i v = _mm256_i32gather_epi32(
+                    reinterpret_cast<const int*>(data_ + done * stride_), offsets, 1);
+
+                const __m256i is_deleted = _mm256_cmpeq_epi32(_mm256_and_si256(v, low_byte), flag);
+                const std::uint64_t mask =
+                    ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(is_deleted))) & 0xFF;
+
+                bits_[done / 64] |= mask << (done % 64);
+            }
+
+            return done;
+        }
+
+#endif
+
+    }
+
+
+    void live_bitmap(
+        const void* data_, std::size_t stride_, std::size_t count_,
+        std::uint64_t* bits_) noexcept
+    {
+        const auto* data = static_cast<const std::uint8_t*>(data_);
+        std::memset(bits_, 0, (count_ + 63) / 64 * sizeof(std::uint64_t));
+
+        std::size_t done = 0;
+
+#ifdef ROWS_AVX2
+        if (use_avx2 &&
+            stride_ >= 4 &&
+            stride_ <= INT32_MAX / 8)
+        {
+            done = live_avx2(data, stride_, count_, bits_);
+        }
+#endif
+
+        live_scalar(data, stride_, done, count_, bits_);
+    }
+
+}
@@ -0,0 +1,78 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Bitmaps of table records in buffer.
+
+   First byte of each record is deletion flag (1 - deleted). Flags of records
+   readed one by one to buffer are collected to bitmap (bit per record, 64
+   records in one word) by AVX2 gather, if processor supports it, or by
+   scalar code without branches. Set bits are walked by 'for_each_bit()'.
+
+   Usage:
+   Call 'live_bitmap()' with buffer of records and bitmap of
+   '(count_ + 63) / 64' words at least. Bits above 'count_' are cleared.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace rows
+{
+
+    // Bit 'i' is set if record 'i' is not deleted.
+    void live_bitmap(
+        const void* data_, std::size_t stride_, std::size_t count_,
+        std::uint64_t* bits_) noexcept;
+
+
+    // Index of the lowest set bit, 'value_' is not zero.
+    inline unsigned lowest_bit(std::uint64_t value_) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value_);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(value_));
+#endif
+    }
+
+
+    // Calls 'func_(i)' for each set bit of 'count_' bits.
+    template <typename Tfunc>
+    void for_each_bit(const std::uint64_t* bits_, std::size_t count_, Tfunc func_)
+    {
+        for (std::size_t w = 0; w * 64 < count_; ++w)
+        {
+            std::uint64_t word = bits_[w];
+
+            if (count_ - w * 64 < 64)                       // Bits above 'count_' in the last word.
+                word &= (std::uint64_t(1) << (count_ - w * 64)) - 1;
+
+            for (; word != 0; word &= word - 1)
+                func_(w * 64 + lowest_bit(word));
+        }
+    }
+
+}
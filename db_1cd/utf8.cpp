@@ -0,0 +1,297 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <cstdint>
+
+#include "utf8.h"
+#include "cpu.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define UTF8_SSE2
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#define UTF8_AVX2_FUNC
+#else
+#define UTF8_AVX2_FUNC __attribute__((target("avx2")))
+#endif
+#endif
+
+
+namespace utf8
+{
+
+    namespace
+    {
+
+        // Decodes one character, moves 'in_' and 'out_'. Returns 'false' for invalid data.
+        inline bool scalar_one(
+            const std::uint8_t*& in_, const std::uint8_t* end_,
+            char16_t*& out_) noexcept
+        {
+            const std::uint8_t* in = in_;
+            const std::uint32_t c0 = *in;
+
+            if (c0 < 0x80)
+            {
+                *out_++ = static_cast<char16_t>(c0);
+                in_ = in + 1;
+                return true;
+            }
+
+            if (c0 < 0xC2)                                  // Continuation or overlong 2-byte.
+                return false;
+
+            if (c0 < 0xE0)
+            {
+                if (end_ - in < 2 ||
+                    (in[1] & 0xC0) != 0x80)
+                {
+                    return false;
+                }
+
+                *out_++ = static_cast<char16_t>(((c0 & 0x1F) << 6) | (in[1] & 0x3F));
+                in_ = in + 2;
+                return true;
+            }
+
+            if (c0 < 0xF0)
+            {
+                if (end_ - in < 3 ||
+                    (in[1] & 0xC0) != 0x80 ||
+                    (in[2] & 0xC0) != 0x80 ||
+                    (c0 == 0xE0 && in[1] < 0xA0) ||         // Overlong.
+                    (c0 == 0xED && in[1] >= 0xA0))          // Surrogate.
+                {
+                    return false;
+                }
+
+                *out_++ = static_cast<char16_t>(
+                    ((c0 & 0x0F) << 12) | ((in[1] & 0x3F) << 6) | (in[2] & 0x3F));
+                in_ = in + 3;
+                return true;
+            }
+
+            if (c0 < 0xF5)
+            {
+                if (end_ - in < 4 ||
+                    (in[1] & 0xC0) != 0x80 ||
+                    (in[2] & 0xC0) != 0x80 ||
+                    (in[3] & 0xC0) != 0x80 ||
+                    (c0 == 0xF0 && in[1] < 0x90) ||         // Overlong.
+                    (c0 == 0xF4 && in[1] >= 0x90))          // Above U+10FFFF.
+                {
+                    return false;
+                }
+
+                const std::uint32_t cp =
+                    ((c0 & 0x07) << 18) | ((in[1] & 0x3F) << 12) |
+                    ((in[2] & 0x3F) << 6) | (in[3] & 0x3F);
+
+                *out_++ = static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+                *out_++ = static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+                in_ = in + 4;
+                return true;
+            }
+
+            return false;
+        }
+
+
+        // Length of the maximal invalid part at 'in_' (prefix of some valid
+        // sequence or one byte), it is replaced by one U+FFFD.
+        inline std::size_t invalid_length(
+            const std::uint8_t* in_, const std::uint8_t* end_) noexcept
+        {
+            const std::uint32_t c0 = *in_;
+
+            if (c0 < 0xC2 || c0 >= 0xF5)
+                return 1;
+
+            const std::size_t length = c0 < 0xE0 ? 2 : c0 < 0xF0 ? 3 : 4;
+
+            // Allowed range of the second byte (no overlong, surrogates, above U+10FFFF).
+            const std::uint8_t low = c0 == 0xE0 ? 0xA0 : c0 == 0xF0 ? 0x90 : 0x80;
+            const std::uint8_t high = c0 == 0xED ? 0x9F : c0 == 0xF4 ? 0x8F : 0xBF;
+
+            std::size_t result = 1;
+
+            if (end_ - in_ > 1 && in_[1] >= low && in_[1] <= high)
+            {
+                ++result;
+
+                while (result < length &&
+                    end_ - in_ > static_cast<std::ptrdiff_t>(result) &&
+                    (in_[result] & 0xC0) == 0x80)
+                {
+                    ++result;
+                }
+            }
+
+            return result;
+        }
+
+
+#ifdef UTF8_SSE2
+
+        const bool use_avx2 = cpu::avx2_supported();
+
+
+        // Converts ASCII blocks of 16 bytes. Returns count of the converted bytes.
+        inline std::size_t ascii_sse2(
+            const std::uint8_t* in_, std::size_t count_,
+            char16_t* out_) noexcept
+        {
+            const __m128i zero = _mm_setzero_si128();
+            std::size_t done = 0;
+
+            while (count_ - done >= 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ + done));
+
+                if (_mm_movemask_epi8(v) != 0)
+                    break;
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ + done), _mm_unpacklo_epi8(v, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ + done + 8), _mm_unpackhi_epi8(v, zero));
+                done += 16;
+            }
+
+            return done;
+        }
+
+
+        // Same as 'ascii_sse2()', by blocks of 32 bytes.
+        UTF8_AVX2_FUNC
+        std::size_t ascii_avx2(
+            const std::uint8_t* in_, std::size_t count_,
+            char16_t* out_) noexcept
+        {
+            std::size_t done = 0;
+
+            while (count_ - done >= 32)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in_ + done));
+
+                if (_mm256_movemask_epi8(v) != 0)
+                    break;
+
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(out_ + done),
+                    _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(out_ + done + 16),
+                    _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+                done += 32;
+            }
+
+            return done + ascii_sse2(in_ + done, count_ - done, out_ + done);
+        }
+
+
+        // Converts blocks of 8 two-byte characters. Returns count of the converted bytes.
+        inline std::size_t pairs_sse2(
+            const std::uint8_t* in_, std::size_t count_,
+            char16_t* out_) noexcept
+        {
+            const __m128i lead_mask = _mm_set1_epi16(0x1F);
+            const __m128i tail_mask = _mm_set1_epi16(0x3F);
+            const __m128i form_mask = _mm_set1_epi16(static_cast<short>(0xC0E0));
+            const __m128i form = _mm_set1_epi16(static_cast<short>(0x80C0));
+            const __m128i overlong_mask = _mm_set1_epi16(0x1E);
+            const __m128i zero = _mm_setzero_si128();
+            std::size_t done = 0;
+
+            while (count_ - done >= 16)
+            {
+                // Little-endian words: low byte - lead byte (110xxxxx), high - continuation (10xxxxxx).
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_ + done));
+
+                const __m128i valid = _mm_andnot_si128(
+                    _mm_cmpeq_epi16(_mm_and_si128(v, overlong_mask), zero),
+                    _mm_cmpeq_epi16(_mm_and_si128(v, form_mask), form));
+
+                if (_mm_movemask_epi8(valid) != 0xFFFF)
+                    break;
+
+                const __m128i chars = _mm_or_si128(
+                    _mm_slli_epi16(_mm_and_si128(v, lead_mask), 6),
+                    _mm_and_si128(_mm_srli_epi16(v, 8), tail_mask));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ + done / 2), chars);
+                done += 16;
+            }
+
+            return done;
+        }
+
+#endif
+
+    }
+
+
+    bool to_utf16(
+        const void* src_, std::size_t src_size_,
+        char16_t* dst_buff_, std::size_t& dst_used_,
+        bool strict_)
+    {
+        const std::uint8_t* in = reinterpret_cast<const std::uint8_t*>(src_);
+        const std::uint8_t* const end = in + src_size_;
+        char16_t* out = dst_buff_;
+
+        bool valid = true;
+
+        dst_used_ = 0;
+
+        while (in != end)
+        {
+#ifdef UTF8_SSE2
+            std::size_t done = use_avx2 ?
+                ascii_avx2(in, end - in, out) :
+                ascii_sse2(in, end - in, out);
+
+            in += done;
+            out += done;
+
+            done = pairs_sse2(in, end - in, out);
+
+            in += done;
+            out += done / 2;
+#endif
+
+            // Scalar part up to next block (not aligned sequences in mixed text).
+            const std::uint8_t* const block_end = end - in > 16 ? in + 16 : end;
+
+            while (in < block_end)
+            {
+                if (!scalar_one(in, end, out))
+                {
+                    if (strict_)
+                        return false;
+
+                    valid = false;
+                    in += invalid_length(in, end);
+                    *out++ = u'\uFFFD';
+                }
+            }
+        }
+
+        dst_used_ = static_cast<std::size_t>(out - dst_buff_);
+        return valid;
+    }
+
+}
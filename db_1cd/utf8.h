@@ -0,0 +1,50 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Conversion UTF-8 strings to UTF-16 with validation.
+
+   UTF-16 string never longer than UTF-8 source (in code units), so result
+   buffer is sized by source and conversion is done in one pass. Blocks of
+   ASCII characters are converted by SSE2 (AVX2, if processor supports it),
+   blocks of two-byte characters (like cyrillic) - by SSE2. The rest and
+   other processors - scalar code.
+   Invalid data: truncated and overlong sequences, surrogates, code points
+   above U+10FFFF. By default each maximal invalid part of sequence is
+   replaced by U+FFFD (like 'MultiByteToWideChar()'), strict conversion stops
+   on it.
+
+   Usage:
+   Call 'to_utf16()' with destination buffer of 'src_size_' characters
+   at least. Returns 'false' if source is not valid UTF-8 (strict conversion
+   has no result then).
+*/
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace utf8
+{
+
+    // 'dst_used_' - length of the result (characters).
+    bool to_utf16(
+        const void* src_, std::size_t src_size_,
+        char16_t* dst_buff_, std::size_t& dst_used_,
+        bool strict_ = false);
+
+}
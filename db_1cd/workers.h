@@ -0,0 +1,265 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Simple pool of worker threads for data-parallel jobs.
+
+   Pool runs one job at a time: 'for_each()' calls function for each item
+   number in range [0, count) and returns after all items processed. Calling
+   thread also processes items, so pool with zero threads works sequentially.
+   First exception thrown by function is rethrown by 'for_each()', the rest
+   items of the job are skipped.
+
+   Don't call 'for_each()' from the function of the same pool - deadlock !
+
+   Usage:
+1. Create pool object once (threads are started in constructor).
+2. Call 'for_each()' with items count and function 'void(std::size_t)'.
+   Function must be thread-safe.
+
+   Class 'background' is one thread for asynchronous tasks (read-ahead and
+   so on): 'run()' queues function and returns at once, completion and
+   errors - by 'std::future'. Tasks are run in order of queuing. Destructor
+   waits for the running task, queued tasks are dropped (their futures get
+   'broken_promise' error).
+*/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <exception>
+#include <utility>
+
+
+namespace workers
+{
+
+    class pool
+    {
+    public:
+        using function_type = std::function<void(std::size_t)>;
+
+    private:
+        std::vector<std::thread> threads;                   // Worker threads.
+        std::mutex job_mtx;                                 // Allows only one job at a time.
+
+        std::mutex mtx;                                     // Protects job state below.
+        std::condition_variable cv_task;                    // Signals to workers: new items or stop.
+        std::condition_variable cv_done;                    // Signals to 'for_each()': all items done.
+
+        const function_type* func = nullptr;                // Function of the current job.
+        std::size_t items_count = 0;                        // Items count in the current job.
+        std::size_t next_item = 0;                          // Next item to process.
+        std::size_t items_done = 0;                         // Processed (or skipped) items.
+        std::exception_ptr error;                           // First error of the current job.
+        bool stop = false;                                  // Pool destroying.
+
+        void run_items(std::unique_lock<std::mutex>& lock_)
+        {
+            while (next_item < items_count)
+            {
+                const std::size_t item = next_item++;
+                const bool skip = static_cast<bool>(error);
+
+                lock_.unlock();
+
+                std::exception_ptr item_error;
+
+                if (!skip)
+                {
+                    try
+                    {
+                        (*func)(item);
+                    }
+                    catch (...)
+                    {
+                        item_error = std::current_exception();
+                    }
+                }
+
+                lock_.lock();
+
+                if (item_error && !error)
+                    error = item_error;
+
+                if (++items_done == items_count)
+                    cv_done.notify_all();
+            }
+        }
+
+        void shutdown() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stop = true;
+            }
+
+            cv_task.notify_all();
+
+            for (auto& thr : threads)
+                thr.join();
+
+            threads.clear();
+        }
+
+        void worker()
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+
+            for (;;)
+            {
+                cv_task.wait(lock, [this] { return stop || next_item < items_count; });
+
+                if (stop)
+                    return;
+
+                run_items(lock);
+            }
+        }
+
+    public:
+        std::size_t size() const noexcept
+        {
+            return threads.size();
+        }
+
+        void for_each(std::size_t count_, const function_type& func_)
+        {
+            if (count_ == 0)
+                return;
+
+            std::lock_guard<std::mutex> job_lock(job_mtx);
+            std::unique_lock<std::mutex> lock(mtx);
+
+            func = &func_;
+            error = nullptr;
+            items_done = 0;
+            next_item = 0;
+            items_count = count_;
+
+            if (count_ > 1)
+                cv_task.notify_all();
+
+            run_items(lock);
+            cv_done.wait(lock, [this] { return items_done == items_count; });
+
+            func = nullptr;
+            items_count = 0;
+            next_item = 0;
+
+            if (error)
+                std::rethrow_exception(std::exchange(error, nullptr));
+        }
+
+        pool(std::size_t threads_ = std::thread::hardware_concurrency())
+        {
+            threads.reserve(threads_);
+
+            try
+            {
+                for (std::size_t i = 0; i < threads_; ++i)
+                    threads.emplace_back(&pool::worker, this);
+            }
+            catch (...)
+            {
+                shutdown();
+                throw;
+            }
+        }
+
+        pool(const pool&) = delete;
+        pool(pool&&) = delete;
+        pool& operator=(const pool&) = delete;
+        pool& operator=(pool&&) = delete;
+
+        ~pool()
+        {
+            shutdown();
+        }
+    };
+
+
+    class background
+    {
+    private:
+        std::mutex mtx;                                     // Protects state below.
+        std::condition_variable cv_task;                    // Signals to thread: new task or stop.
+        std::deque<std::packaged_task<void()>> tasks;       // Queued tasks.
+        bool stop = false;                                  // Object destroying.
+
+        std::thread thread;                                 // Started after initialization of the rest.
+
+        void worker()
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+
+            for (;;)
+            {
+                cv_task.wait(lock, [this] { return stop || !tasks.empty(); });
+
+                if (stop)
+                    return;
+
+                std::packaged_task<void()> task = std::move(tasks.front());
+                tasks.pop_front();
+
+                lock.unlock();
+                task();                                     // Exception is stored in the future.
+                lock.lock();
+            }
+        }
+
+    public:
+        std::future<void> run(std::function<void()> func_)
+        {
+            std::packaged_task<void()> task(std::move(func_));
+            std::future<void> result = task.get_future();
+
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                tasks.push_back(std::move(task));
+            }
+
+            cv_task.notify_one();
+            return result;
+        }
+
+        background() : thread(&background::worker, this) {}
+
+        background(const background&) = delete;
+        background(background&&) = delete;
+        background& operator=(const background&) = delete;
+        background& operator=(background&&) = delete;
+
+        ~background()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stop = true;
+            }
+
+            cv_task.notify_all();
+            thread.join();
+        }
+    };
+
+}
@@ -0,0 +1,353 @@
+/*
+   Library for low-level access to 1CD file database.
+   Copyright (C) 2021 Denis Matveev (denm.mmm@gmail.com).
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/*
+   Benchmark of the BLOB decompression engines and UTF-8 conversion on the data
+   of real database.
+
+   Collects compressed values of all binary BLOB fields (values which can't be
+   decompressed are skipped), then decompresses them by each engine and checks
+   that results are equal to the reference (ZLIB stream).
+   UTF-8 texts (with BOM) are taken from string BLOB fields and decompressed
+   values. They are converted by 'blob::utf8to16()' and by WinAPI (reference).
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <limits>
+#include <cstdlib>
+
+#include "db_1cd_83.h"
+
+
+struct sample
+{
+    db_1cd_83::pages::buffer_type src;                      // Compressed value.
+    db_1cd_83::pages::buffer_type reference;                // Decompressed by ZLIB stream.
+};
+
+
+struct samples
+{
+    std::vector<sample> compressed;                         // Values to decompress.
+    std::vector<db_1cd_83::pages::buffer_type> texts;       // UTF-8 strings with BOM.
+};
+
+
+constexpr std::size_t max_samples_size = 256 * 1024 * 1024; // Limit of BLOB data to collect.
+
+
+bool is_text(const db_1cd_83::pages::buffer_type& value_)
+{
+    return value_.size() > 3 &&
+        value_[0] == 0xEF &&
+        value_[1] == 0xBB &&
+        value_[2] == 0xBF;
+}
+
+
+samples collect(db_1cd_83::pages& pages_)
+{
+    samples result;
+    std::size_t total = 0;
+
+    db_1cd_83::root root(pages_);
+
+    for (db_1cd_83::root::index_type i = 0; i < root.size() && total < max_samples_size; ++i)
+    {
+        const db_1cd_83::table::params params = root.get(i);
+
+        if (params.i_blob == 0)
+            continue;
+
+        std::vector<db_1cd_83::field::fparams> blob_columns;
+
+        for (const auto& column : params.columns)
+        {
+            if (column.type == db_1cd_83::field::ftype::bin_blob ||
+                column.type == db_1cd_83::field::ftype::str_blob)
+            {
+                blob_columns.push_back(column);
+            }
+        }
+
+        if (blob_columns.empty())
+            continue;
+
+        db_1cd_83::records records(pages_, params.i_records, params.columns);
+        db_1cd_83::blob blob(pages_, params.i_blob);
+
+        for (db_1cd_83::records::index_type i_rec = 0;
+            i_rec < records.size() && total < max_samples_size; ++i_rec)
+        {
+            records.seek(i_rec);
+
+            if (records.is_deleted())
+                continue;
+
+            for (const auto& column : blob_columns)
+            {
+                // Each field is readed by its own type.
+                const auto index = records.field_index(column.name);
+                std::uint32_t blob_index = 0;
+                std::uint32_t blob_size = 0;
+
+                if (column.type == db_1cd_83::field::ftype::str_blob)
+                {
+                    const auto field = records.get_field<db_1cd_83::field::str_blob>(index);
+
+                    if (field.exists.has_value())
+                    {
+                        blob_index = field.exists->index;
+                        blob_size = field.exists->size;
+                    }
+                }
+                else
+                {
+                    const auto field = records.get_field<db_1cd_83::field::bin_blob>(index);
+
+                    if (field.exists.has_value())
+                    {
+                        blob_index = field.exists->index;
+                        blob_size = field.exists->size;
+                    }
+                }
+
+                if (blob_size == 0)
+                    continue;
+
+                sample smp;
+                smp.src = blob.get(blob_index, blob_size);
+                total += smp.src.size();
+
+                if (is_text(smp.src))
+                {
+                    result.texts.push_back(std::move(smp.src));
+                    continue;
+                }
+
+                try
+                {
+                    db_1cd_83::blob::decompress(smp.src, smp.reference);
+                }
+                catch (db_1cd_83::exception&)
+                {
+                    continue;                               // Not compressed value.
+                }
+
+                if (is_text(smp.reference))
+                    result.texts.push_back(smp.reference);
+
+                result.compressed.push_back(std::move(smp));
+            }
+        }
+    }
+
+    return result;
+}
+
+
+// Reference conversion.
+std::wstring winapi_utf8to16(const db_1cd_83::pages::buffer_type& src_)
+{
+    auto src_ptr = reinterpret_cast<LPCCH>(&src_[3]);
+    const int src_size = static_cast<int>(src_.size() - 3);
+
+    std::wstring result;
+    result.resize(::MultiByteToWideChar(CP_UTF8, 0, src_ptr, src_size, nullptr, 0));
+
+    ::MultiByteToWideChar(
+        CP_UTF8, 0,
+        src_ptr, src_size,
+        &result[0], static_cast<int>(result.size()));
+
+    return result;
+}
+
+
+// Returns converted bytes of UTF-8 per second.
+double measure_text(
+    const std::vector<db_1cd_83::pages::buffer_type>& texts_,
+    bool winapi_,
+    unsigned repeats_)
+{
+    std::size_t total = 0;
+
+    for (const auto& text : texts_)
+    {
+        if (!winapi_ && db_1cd_83::blob::utf8to16(text) != winapi_utf8to16(text))
+        {
+            throw db_1cd_83::exception(
+                "Result of UTF-8 conversion differs from the reference.");
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (unsigned r = 0; r < repeats_; ++r)
+    {
+        for (const auto& text : texts_)
+        {
+            const std::wstring str = winapi_ ?
+                winapi_utf8to16(text) :
+                db_1cd_83::blob::utf8to16(text);
+
+            total += text.size();
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() > 0 ? total / elapsed.count() : 0;
+}
+
+
+// Returns decompressed bytes per second. 'engine_' is 'nullptr' - ZLIB stream without size hint.
+double measure(
+    const std::vector<sample>& samples_,
+    const db_1cd_83::blob::inflate_engine* engine_,
+    unsigned repeats_)
+{
+    db_1cd_83::pages::buffer_type dst;
+    std::size_t total = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (unsigned r = 0; r < repeats_; ++r)
+    {
+        for (const auto& smp : samples_)
+        {
+            if (engine_)
+            {
+                db_1cd_83::blob::decompress(
+                    smp.src, dst,
+                    std::numeric_limits<uInt>::max(), smp.reference.size(),
+                    engine_);
+            }
+            else
+                db_1cd_83::blob::decompress(smp.src, dst);
+
+            if (dst != smp.reference)
+            {
+                throw db_1cd_83::exception(
+                    "Result of decompression differs from the reference.");
+            }
+
+            total += dst.size();
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() > 0 ? total / elapsed.count() : 0;
+}
+
+
+int wmain(int argc, wchar_t* argv[])
+{
+    if (argc != 2 && argc != 3)
+    {
+        std::cout << "Pass DB file name and repeats count (optional) as parameters." << std::endl;
+        return 0;
+    }
+
+    try
+    {
+        db_1cd_83::pages pages(64);
+        const db_1cd_83::pages::error err = pages.open(argv[1]);
+
+        if (!err)
+        {
+            std::cout << err.to_string() << std::endl;
+            return -1;
+        }
+
+        const unsigned repeats = argc == 3 ? std::wcstoul(argv[2], nullptr, 10) : 5;
+        const samples smp = collect(pages);
+
+        std::size_t src_total = 0;
+        std::size_t dst_total = 0;
+        std::size_t text_total = 0;
+
+        for (const auto& value : smp.compressed)
+        {
+            src_total += value.src.size();
+            dst_total += value.reference.size();
+        }
+
+        for (const auto& text : smp.texts)
+            text_total += text.size();
+
+        std::cout
+            << "Values: " << smp.compressed.size()
+            << ", compressed: " << src_total
+            << ", decompressed: " << dst_total << std::endl
+            << "Texts: " << smp.texts.size()
+            << ", size: " << text_total << std::endl;
+
+        const db_1cd_83::blob::zlib_engine zlib;
+        const db_1cd_83::blob::fast_engine fast;
+
+        struct
+        {
+            const char* name;
+            const db_1cd_83::blob::inflate_engine* engine;
+        } const runs[] = {
+            { "zlib stream", nullptr },
+            { zlib.name(), &zlib },
+            { fast.name(), &fast }
+        };
+
+        std::cout << std::fixed << std::setprecision(1) << std::left;
+
+        for (const auto& run : runs)
+        {
+            if (smp.compressed.empty())
+                break;
+
+            const double speed = measure(smp.compressed, run.engine, repeats);
+
+            std::cout
+                << std::setw(12) << run.name
+                << speed / (1024 * 1024) << " MB/s" << std::endl;
+        }
+
+        for (const bool winapi : { true, false })
+        {
+            if (smp.texts.empty())
+                break;
+
+            const double speed = measure_text(smp.texts, winapi, repeats);
+
+            std::cout
+                << std::setw(12) << (winapi ? "winapi" : "utf8to16")
+                << speed / (1024 * 1024) << " MB/s" << std::endl;
+        }
+    }
+    catch (db_1cd_83::exception& e)
+    {
+        std::cout << "Internal error: " << e.what() << std::endl;
+        return -1;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Unhandled error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
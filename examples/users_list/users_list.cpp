@@ -16,15 +16,33 @@
 */
 /*
    Example of extraction a list of the users from database.
+   Records are iterated by generator of 'records::generate()' (C++20).
 */
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <optional>
 
 #include "db_1cd_83.h"
 
 
+// Used fields of the table 'V8USERS'.
+struct user_name
+{
+    static constexpr std::wstring_view name = L"NAME";
+    using type = db_1cd_83::field::str_var;
+};
+
+struct user_show
+{
+    static constexpr std::wstring_view name = L"SHOW";
+    using type = db_1cd_83::field::boolean;
+};
+
+using users_schema = db_1cd_83::records::schema<user_name, user_show>;
+
+
 std::optional<db_1cd_83::table::params> find_table(db_1cd_83::pages& pages_, const std::wstring& name_)
 {
     db_1cd_83::root root(pages_);
@@ -75,22 +93,17 @@ int wmain(int argc, wchar_t* argv[])
             params->i_records,
             params->columns);
 
-        for (db_1cd_83::records::index_type i = 0; i < records.size(); ++i)
-        {
-            records.seek(i);
-
-            if (!records.is_deleted())
-            {
-                auto field_name = records.get_field<db_1cd_83::field::str_var>(
-                    records.field_index(L"NAME"));
+        const users_schema users(records);
 
-                auto field_show = records.get_field<db_1cd_83::field::boolean>(
-                    records.field_index(L"SHOW"));
+        // Live records only, next batch is readed while this one is printed.
+        for (const auto& item : records.generate({}))
+        {
+            const auto name = users.get<user_name>(item.view);
+            const auto show = users.get<user_show>(item.view);
 
-                std::wcout
-                    << (field_show.exists.value() ? L"+ " : L"- ")
-                    << field_name.exists.value() << std::endl;
-            }
+            std::wcout
+                << (show.value() ? L"+ " : L"- ")
+                << std::wstring(name->begin(), name->end()) << std::endl;
         }
     }
     catch (db_1cd_83::exception& e)